@@ -10,6 +10,7 @@
 #include <memory>
 #include "Common.h"
 #include "ElunaUtility.h"
+#include "Hooks.h"
 #include <type_traits>
 
 extern "C"
@@ -40,12 +41,14 @@ private:
         lua_State* L;
         uint32 remainingShots;
         int functionReference;
+        uint8 priority;
 
-        Binding(lua_State* L, uint64 id, int functionReference, uint32 remainingShots) :
+        Binding(lua_State* L, uint64 id, int functionReference, uint32 remainingShots, uint8 priority) :
             id(id),
             L(L),
             remainingShots(remainingShots),
-            functionReference(functionReference)
+            functionReference(functionReference),
+            priority(priority)
         { }
 
         ~Binding()
@@ -82,12 +85,14 @@ public:
      *
      * If `shots` is 0, it will never automatically expire, but can still be
      *   removed with `Clear` or `Remove`.
+     *
+     * `priority` is one of `Hooks::BindingPriorities`, see `PushRefsFor`.
      */
-    uint64 Insert(const K& key, int ref, uint32 shots)
+    uint64 Insert(const K& key, int ref, uint32 shots, uint8 priority = Hooks::BINDING_PRIORITY_NORMAL)
     {
         uint64 id = (++maxBindingID);
         BindingList& list = bindings[key];
-        list.push_back(std::unique_ptr<Binding>(new Binding(L, id, ref, shots)));
+        list.push_back(std::unique_ptr<Binding>(new Binding(L, id, ref, shots, priority)));
         id_lookup_table[id] = &list;
         return id;
     }
@@ -175,8 +180,11 @@ public:
 
     /*
      * Push all Lua references for `key` onto the stack.
+     *
+     * Bindings with a priority of `shedPriority` or lower are skipped without
+     *   using up a shot, and counted per priority in `shedCounts`.
      */
-    void PushRefsFor(const K& key)
+    void PushRefsFor(const K& key, uint8 shedPriority = Hooks::BINDING_PRIORITY_COUNT, uint64* shedCounts = NULL)
     {
         if (bindings.empty())
             return;
@@ -191,6 +199,13 @@ public:
             std::unique_ptr<Binding>& binding = (*i);
             auto i_prev = (i++);
 
+            if (binding->priority >= shedPriority)
+            {
+                if (shedCounts)
+                    ++shedCounts[binding->priority];
+                continue;
+            }
+
             lua_rawgeti(L, LUA_REGISTRYINDEX, binding->functionReference);
 
             if (binding->remainingShots > 0)
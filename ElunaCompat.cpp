@@ -86,3 +86,17 @@ void luaL_setmetatable(lua_State* L, const char* tname) {
 }
 #endif
 #endif
+
+#if LUA_VERSION_NUM < 504
+int eluna_resume(lua_State* L, lua_State* from, int narg, int* nres) {
+#if LUA_VERSION_NUM == 501
+    (void)from;
+    int status = lua_resume(L, narg);
+#else
+    int status = lua_resume(L, from, narg);
+#endif
+    // Only the yielded or returned values are left on the stack of the coroutine
+    *nres = lua_gettop(L);
+    return status;
+}
+#endif
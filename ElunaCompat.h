@@ -37,6 +37,19 @@ extern "C"
 #endif
 #endif
 
+/* Lua 5.3 and newer have 64-bit integers, so int64, uint64 and ObjectGuid don't need to be boxed in userdata */
+#if LUA_VERSION_NUM >= 503
+    #define ELUNA_NATIVE_INT64
+#endif
+
+/* lua_resume with the Lua 5.4 signature, which also returns the amount of values yielded or returned */
+#if LUA_VERSION_NUM < 504
+    int eluna_resume(lua_State* L, lua_State* from, int narg, int* nres);
+#else
+    #define eluna_resume(L, from, narg, nres) \
+        lua_resume(L, from, narg, nres)
+#endif
+
 #if LUA_VERSION_NUM > 502
     #define lua_dump(L, writer, data) \
         lua_dump(L, writer, data, 0)
@@ -38,6 +38,9 @@ void ElunaConfig::Initialize()
     SetConfig(CONFIG_ELUNA_ENABLE_UNSAFE, "Eluna.UseUnsafeMethods", true);
     SetConfig(CONFIG_ELUNA_ENABLE_DEPRECATED, "Eluna.UseDeprecatedMethods", true);
     SetConfig(CONFIG_ELUNA_ENABLE_RELOAD_COMMAND, "Eluna.ReloadCommand", true);
+    SetConfig(CONFIG_ELUNA_METHOD_PROFILING, "Eluna.MethodProfiling", false);
+    SetConfig(CONFIG_ELUNA_SPREAD_REPEATING_EVENTS, "Eluna.SpreadRepeatingEvents", false);
+    SetConfig(CONFIG_ELUNA_NATIVE_INT64, "Eluna.NativeInt64", false);
 
     // Load strings
     SetConfig(CONFIG_ELUNA_SCRIPT_PATH, "Eluna.ScriptPath", "lua_scripts");
@@ -47,6 +50,9 @@ void ElunaConfig::Initialize()
 
     // Load ints
     SetConfig(CONFIG_ELUNA_RELOAD_SECURITY_LEVEL, "Eluna.ReloadSecurityLevel", 3);
+    // Lua time per tick in microseconds, used both to shed cosmetic bindings and to stop the timed events and query callbacks of a tick
+    SetConfig(CONFIG_ELUNA_TICK_BUDGET, "Eluna.TickBudget", 0);
+    SetConfig(CONFIG_ELUNA_UPDATE_CALL_LIMIT, "Eluna.UpdateCallLimit", 0);
 
     // Call extra functions
     TokenizeAllowedMaps();
@@ -17,6 +17,9 @@ enum ElunaConfigBoolValues
     CONFIG_ELUNA_ENABLE_UNSAFE,
     CONFIG_ELUNA_ENABLE_DEPRECATED,
     CONFIG_ELUNA_ENABLE_RELOAD_COMMAND,
+    CONFIG_ELUNA_METHOD_PROFILING,
+    CONFIG_ELUNA_SPREAD_REPEATING_EVENTS,
+    CONFIG_ELUNA_NATIVE_INT64,
     CONFIG_ELUNA_BOOL_COUNT
 };
 
@@ -32,6 +35,8 @@ enum ElunaConfigStringValues
 enum ElunaConfigUInt32Values
 {
     CONFIG_ELUNA_RELOAD_SECURITY_LEVEL,
+    CONFIG_ELUNA_TICK_BUDGET,
+    CONFIG_ELUNA_UPDATE_CALL_LIMIT,
     CONFIG_ELUNA_INT_COUNT
 };
 
@@ -56,6 +61,11 @@ public:
     bool UnsafeMethodsEnabled() { return GetConfig(CONFIG_ELUNA_ENABLE_UNSAFE); }
     bool DeprecatedMethodsEnabled() { return GetConfig(CONFIG_ELUNA_ENABLE_DEPRECATED); }
     bool IsReloadCommandEnabled() { return GetConfig(CONFIG_ELUNA_ENABLE_RELOAD_COMMAND); }
+    bool IsMethodProfilingEnabled() { return GetConfig(CONFIG_ELUNA_METHOD_PROFILING); }
+    bool IsSpreadRepeatingEventsEnabled() { return GetConfig(CONFIG_ELUNA_SPREAD_REPEATING_EVENTS); }
+    bool IsNativeInt64Enabled() { return GetConfig(CONFIG_ELUNA_NATIVE_INT64); }
+    uint32 GetTickBudget() { return GetConfig(CONFIG_ELUNA_TICK_BUDGET); }
+    uint32 GetUpdateCallLimit() { return GetConfig(CONFIG_ELUNA_UPDATE_CALL_LIMIT); }
     AccountTypes GetReloadSecurityLevel() { return static_cast<AccountTypes>(GetConfig(CONFIG_ELUNA_RELOAD_SECURITY_LEVEL)); }
     bool ShouldMapLoadEluna(uint32 mapId);
 
@@ -5,6 +5,7 @@
 */
 
 #include "ElunaEventMgr.h"
+#include "ElunaConfig.h"
 #include "LuaEngine.h"
 #if !defined ELUNA_CMANGOS
 #include "Object.h"
@@ -18,46 +19,259 @@ extern "C"
 #include "lauxlib.h"
 };
 
+#include <new>
+
+LuaEvent* LuaEventPool::Create(int funcRef, uint32 min, uint32 max, uint32 repeats)
+{
+    if (!freeList)
+    {
+        chunks.emplace_back(new Slot[CHUNK_SIZE]);
+        Slot* chunk = chunks.back().get();
+        for (uint32 i = 0; i < CHUNK_SIZE; ++i)
+            chunk[i].nextFree = i + 1 < CHUNK_SIZE ? &chunk[i + 1] : nullptr;
+
+        freeList = chunk;
+        stats.capacity += CHUNK_SIZE;
+    }
+
+    Slot* slot = freeList;
+    freeList = slot->nextFree;
+
+    ++stats.allocations;
+    stats.peak = std::max(stats.peak, ++stats.live);
+    return new (slot->storage) LuaEvent(funcRef, min, max, repeats);
+}
+
+void LuaEventPool::Destroy(LuaEvent* luaEvent)
+{
+    luaEvent->~LuaEvent();
+
+    Slot* slot = reinterpret_cast<Slot*>(luaEvent);
+    slot->nextFree = freeList;
+    freeList = slot;
+
+    ++stats.frees;
+    --stats.live;
+}
+
+ElunaTimingWheel::ElunaTimingWheel() : occupied(), levelOccupied(), time(0), count(0)
+{
+}
+
+void ElunaTimingWheel::Insert(LuaEvent* luaEvent, uint64 expiry)
+{
+    luaEvent->expiry = expiry;
+    ++count;
+    Place(luaEvent);
+}
+
+void ElunaTimingWheel::Place(LuaEvent* luaEvent)
+{
+    uint64 expiry = luaEvent->expiry;
+    if (expiry < time)
+    {
+        overdue.Append(luaEvent);
+        return;
+    }
+
+    uint64 delta = expiry - time;
+    if (delta < LEVEL0_SIZE)
+    {
+        uint32 index = expiry & LEVEL0_MASK;
+        level0[index].Append(luaEvent);
+        occupied[index / 64] |= uint64(1) << (index % 64);
+        return;
+    }
+
+    // Events beyond the last level are placed in it and placed again when they are cascaded
+    uint32 level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (uint64(1) << (LEVEL0_BITS + (level + 1) * LEVEL_BITS)))
+        ++level;
+
+    uint32 index = (expiry >> (LEVEL0_BITS + level * LEVEL_BITS)) & LEVEL_MASK;
+    levels[level][index].Append(luaEvent);
+    levelOccupied[level] |= uint64(1) << index;
+}
+
+int ElunaTimingWheel::FindFirstBit(uint64 bits)
+{
+    if (!bits)
+        return -1;
+
+    // De Bruijn multiplication of the isolated lowest bit
+    static const int positions[64] =
+    {
+        0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+    };
+    return positions[((bits & (~bits + 1)) * 0x03f79d71b4cb0a89ull) >> 58];
+}
+
+int ElunaTimingWheel::FindOccupiedSlot(uint32 index) const
+{
+    for (uint32 word = index / 64; word < LEVEL0_SIZE / 64; ++word)
+    {
+        uint64 bits = occupied[word];
+        if (word == index / 64)
+            bits &= ~uint64(0) << (index % 64);
+
+        if (bits)
+            return word * 64 + FindFirstBit(bits);
+    }
+    return -1;
+}
+
+bool ElunaTimingWheel::IsLevel0Empty() const
+{
+    for (uint64 bits : occupied)
+        if (bits)
+            return false;
+    return true;
+}
+
+uint64 ElunaTimingWheel::GetNextCascade(uint64 from) const
+{
+    uint64 next = UINT64_MAX;
+    for (uint32 level = 0; level < LEVEL_COUNT; ++level)
+    {
+        uint64 bits = levelOccupied[level];
+        if (!bits)
+            continue;
+
+        // The slots of a level are cascaded in turn, each at a multiple of the span of the levels below it
+        uint32 shift = LEVEL0_BITS + level * LEVEL_BITS;
+        uint64 turn = (from + (uint64(1) << shift) - 1) >> shift;
+        uint32 start = turn & LEVEL_MASK;
+        uint64 rotated = start ? (bits >> start) | (bits << (LEVEL_SIZE - start)) : bits;
+
+        next = std::min(next, (turn + FindFirstBit(rotated)) << shift);
+    }
+    return next;
+}
+
+uint64 ElunaTimingWheel::GetNextExpiry() const
+{
+    if (!count)
+        return UINT64_MAX;
+    if (overdue.head)
+        return overdue.head->expiry;
+
+    uint64 next = GetNextCascade(time);
+
+    uint32 index = time & LEVEL0_MASK;
+    int slot = FindOccupiedSlot(index);
+    if (slot >= 0)
+        next = std::min(next, time - index + slot);
+    else if ((slot = FindOccupiedSlot(0)) >= 0)
+        next = std::min(next, time - index + LEVEL0_SIZE + slot);
+
+    return next;
+}
+
+void ElunaTimingWheel::Cascade()
+{
+    // Each level is cascaded when the level below it wraps around
+    for (uint32 level = 0; level < LEVEL_COUNT; ++level)
+    {
+        uint32 index = (time >> (LEVEL0_BITS + level * LEVEL_BITS)) & LEVEL_MASK;
+
+        Slot slot = levels[level][index];
+        levels[level][index] = Slot();
+        levelOccupied[level] &= ~(uint64(1) << index);
+        for (LuaEvent* luaEvent = slot.head; luaEvent;)
+        {
+            LuaEvent* next = luaEvent->next;
+            Place(luaEvent);
+            luaEvent = next;
+        }
+
+        if (index)
+            break;
+    }
+}
+
+void ElunaTimingWheel::Clear()
+{
+    overdue = Slot();
+    for (Slot& slot : level0)
+        slot = Slot();
+    for (auto& level : levels)
+        for (Slot& slot : level)
+            slot = Slot();
+    std::fill(std::begin(occupied), std::end(occupied), 0);
+    std::fill(std::begin(levelOccupied), std::end(levelOccupied), 0);
+    count = 0;
+}
+
 ElunaEventProcessor::~ElunaEventProcessor()
 {
     ClearAllEvents();
 }
 
-void ElunaEventProcessor::Update(uint32 diff)
+bool ElunaEventProcessor::Update()
 {
+    if (!eventWheel)
+        return false;
+
     isUpdating = true;
 
-    m_time += diff;
-    while (!eventList.empty() && eventList.begin()->first <= m_time)
+    bool finished = eventWheel->Advance(mgr->time, [this](LuaEvent* luaEvent)
     {
-        auto it = eventList.begin();
-        LuaEvent* luaEvent = it->second;
-        eventList.erase(it);
-
         if (luaEvent->state != LUAEVENT_STATE_ERASE)
             eventMap.erase(luaEvent->funcRef);
 
-        if (luaEvent->state == LUAEVENT_STATE_RUN)
+        if (luaEvent->state == LUAEVENT_STATE_RUN && luaEvent->coroutine)
+        {
+            // The coroutine of an object that is not in the world keeps waiting
+            bool wait = true;
+            if (!obj || obj->IsInWorld())
+            {
+                // Kept in the map while it runs, so the coroutine can remove itself by its ID
+                eventMap[luaEvent->funcRef] = luaEvent;
+                wait = mgr->E->OnCoroutineEvent(luaEvent, mgr->time);
+                mgr->E->SpendUpdateBudget();
+
+                if (!wait)
+                    eventMap.erase(luaEvent->funcRef);
+            }
+
+            if (wait)
+            {
+                AddEvent(luaEvent); // deferred until the end of the update
+                return mgr->E->HasUpdateBudget();
+            }
+        }
+        else if (luaEvent->state == LUAEVENT_STATE_RUN)
         {
             uint32 delay = luaEvent->delay;
             bool remove = luaEvent->repeats == 1;
             if (!remove)
-                AddEvent(luaEvent); // may be deferred if we recurse into Update
+                AddEvent(luaEvent); // deferred until the end of the update
 
             // Call the timed event
             if (!obj || (obj && obj->IsInWorld()))
+            {
                 mgr->E->OnTimedEvent(luaEvent->funcRef, delay, luaEvent->repeats ? luaEvent->repeats-- : luaEvent->repeats, obj);
+                mgr->E->SpendUpdateBudget();
+            }
 
             if (!remove)
-                continue;
+                return mgr->E->HasUpdateBudget();
         }
 
         // Event should be deleted (executed last time or set to be aborted)
         RemoveEvent(luaEvent);
-    }
+        return mgr->E->HasUpdateBudget();
+    });
 
     isUpdating = false;
+
+    // Events added back during the update are not in the wheel yet, so only the events the budget left are counted
+    bool carried = !finished && eventWheel->GetNextExpiry() <= mgr->time;
     ProcessDeferredOps();
+    return carried;
 }
 
 void ElunaEventProcessor::SetStates(LuaEventState state)
@@ -68,8 +282,8 @@ void ElunaEventProcessor::SetStates(LuaEventState state)
         return;
     }
 
-    for (auto& [time, event] : eventList)
-        event->SetState(state);
+    if (eventWheel)
+        eventWheel->ForEach([state](LuaEvent* event) { event->SetState(state); });
 
     if (state == LUAEVENT_STATE_ERASE)
         eventMap.clear();
@@ -83,11 +297,17 @@ void ElunaEventProcessor::ClearAllEvents()
         return;
     }
 
-    for (auto& [time, event] : eventList)
-        RemoveEvent(event);
+    if (eventWheel)
+        eventWheel->ForEach([this](LuaEvent* event) { RemoveEvent(event); });
+
+    // Events that were waiting to be added are removed with the rest
+    for (DeferredOp& op : deferredOps)
+        if (op.type == DeferredOpType::AddEvent)
+            RemoveEvent(op.event);
 
     deferredOps.clear();
-    eventList.clear();
+    if (eventWheel)
+        eventWheel->Clear();
     eventMap.clear();
 }
 
@@ -115,14 +335,40 @@ void ElunaEventProcessor::AddEvent(LuaEvent* luaEvent)
         return;
     }
 
+    if (!eventWheel)
+        eventWheel = std::make_unique<ElunaTimingWheel>();
+
+    // A wheel without events is not advanced while the processor is not scheduled
+    if (eventWheel->IsEmpty())
+        eventWheel->Advance(mgr->time, [](LuaEvent*) { return true; });
+
     luaEvent->GenerateDelay();
-    eventList.emplace(m_time + luaEvent->delay, luaEvent);
+    uint64 expiry = mgr->time + luaEvent->delay + luaEvent->offset;
+    luaEvent->offset = 0;
+    eventWheel->Insert(luaEvent, expiry);
     eventMap[luaEvent->funcRef] = luaEvent;
+
+    if (scheduleIndex == NOT_SCHEDULED || expiry < nextUpdate)
+        mgr->Schedule(this);
+}
+
+void ElunaEventProcessor::AddEvent(int funcRef, uint32 min, uint32 max, uint32 repeats, uint32 jitter)
+{
+    LuaEvent* luaEvent = mgr->eventPool.Create(funcRef, min, max, repeats);
+    if (jitter)
+        luaEvent->offset = urand(0, jitter);
+    else if (repeats != 1 && min && min == max && sElunaConfig->IsSpreadRepeatingEventsEnabled())
+        luaEvent->offset = mgr->GetSpreadOffset(min);
+
+    AddEvent(luaEvent);
 }
 
-void ElunaEventProcessor::AddEvent(int funcRef, uint32 min, uint32 max, uint32 repeats)
+void ElunaEventProcessor::AddCoroutine(int threadRef, uint32 delay, uint32 timeout)
 {
-    AddEvent(new LuaEvent(funcRef, min, max, repeats));
+    LuaEvent* luaEvent = mgr->eventPool.Create(threadRef, delay, delay, 1);
+    luaEvent->coroutine = true;
+    luaEvent->deadline = timeout ? mgr->time + timeout : 0;
+    AddEvent(luaEvent);
 }
 
 void ElunaEventProcessor::RemoveEvent(LuaEvent* luaEvent)
@@ -133,7 +379,7 @@ void ElunaEventProcessor::RemoveEvent(LuaEvent* luaEvent)
         // Free lua function ref
         luaL_unref(mgr->E->L, LUA_REGISTRYINDEX, luaEvent->funcRef);
     }
-    delete luaEvent;
+    mgr->eventPool.Destroy(luaEvent);
 }
 
 void ElunaEventProcessor::QueueDeferredOp(DeferredOpType type, LuaEvent* event, int eventId, LuaEventState state)
@@ -175,7 +421,7 @@ ElunaProcessorInfo::~ElunaProcessorInfo()
         mgr->FlagObjectProcessorForDeletion(processorId);
 }
 
-EventMgr::EventMgr(Eluna* _E) : E(_E)
+EventMgr::EventMgr(Eluna* _E) : E(_E), time(0), carriedProcessors(0)
 {
     auto gp = std::make_unique<ElunaEventProcessor>(this, nullptr);
     processors.insert(gp.get());
@@ -184,6 +430,7 @@ EventMgr::EventMgr(Eluna* _E) : E(_E)
 
 EventMgr::~EventMgr()
 {
+    schedule.clear();
     globalProcessors.clear();
     objectProcessors.clear();
     processors.clear();
@@ -192,19 +439,131 @@ EventMgr::~EventMgr()
 
 void EventMgr::UpdateProcessors(uint32 diff)
 {
-    // iterate a copy because processors may be destroyed during update (creature removed by a script, etc)
-    ProcessorSet copy = processors;
+    time += diff;
+
+    // Take all due processors first, so that each is updated at most once even if the updates add events to them
+    dueProcessors.clear();
+    while (!schedule.empty() && schedule.front()->nextUpdate <= time)
+    {
+        ElunaEventProcessor* processor = schedule.front();
+        Unschedule(processor);
+        dueProcessors.push_back(processor);
+    }
 
-    for (auto* processor : copy)
+    // Processors removed during the updates (creature removed by a script, etc) are only flagged, they are destroyed by CleanupObjectProcessors
+    // When the update budget of the state runs out, the processors left keep their due time and are updated first on the next tick
+    carriedProcessors = 0;
+    for (ElunaEventProcessor* processor : dueProcessors)
     {
-        if (processors.find(processor) != processors.end())
-            if (!processor->pendingDeletion)
-                processor->Update(diff);
+        if (processor->pendingDeletion)
+            continue;
+
+        bool carried = E->HasUpdateBudget() ? processor->Update() : true;
+        Schedule(processor);
+
+        if (carried)
+            ++carriedProcessors;
     }
 
     CleanupObjectProcessors();
 }
 
+uint32 EventMgr::GetSpreadOffset(uint32 interval)
+{
+    uint32 count = spreadCounts[interval]++;
+
+    // Reversing the bits of the count gives 0, 1/2, 1/4, 3/4, 1/8.. of the interval
+    count = (count >> 16) | (count << 16);
+    count = ((count & 0xff00ff00) >> 8) | ((count & 0x00ff00ff) << 8);
+    count = ((count & 0xf0f0f0f0) >> 4) | ((count & 0x0f0f0f0f) << 4);
+    count = ((count & 0xcccccccc) >> 2) | ((count & 0x33333333) << 2);
+    count = ((count & 0xaaaaaaaa) >> 1) | ((count & 0x55555555) << 1);
+    uint64 phase = (uint64(count) * interval) >> 32;
+
+    // The phase is of the processor time, so events added at different times are spread as well
+    uint64 expiry = time + interval;
+    return uint32((phase + interval - expiry % interval) % interval);
+}
+
+void EventMgr::Schedule(ElunaEventProcessor* processor)
+{
+    uint64 nextUpdate = processor->eventWheel ? processor->eventWheel->GetNextExpiry() : UINT64_MAX;
+    if (nextUpdate == UINT64_MAX || processor->pendingDeletion)
+    {
+        Unschedule(processor);
+        return;
+    }
+
+    if (processor->scheduleIndex == ElunaEventProcessor::NOT_SCHEDULED)
+    {
+        processor->scheduleIndex = schedule.size();
+        schedule.push_back(processor);
+    }
+
+    processor->nextUpdate = nextUpdate;
+    SiftUp(processor->scheduleIndex);
+    SiftDown(processor->scheduleIndex);
+}
+
+void EventMgr::Unschedule(ElunaEventProcessor* processor)
+{
+    size_t index = processor->scheduleIndex;
+    if (index == ElunaEventProcessor::NOT_SCHEDULED)
+        return;
+
+    processor->scheduleIndex = ElunaEventProcessor::NOT_SCHEDULED;
+
+    ElunaEventProcessor* last = schedule.back();
+    schedule.pop_back();
+    if (last == processor)
+        return;
+
+    schedule[index] = last;
+    last->scheduleIndex = index;
+    SiftUp(index);
+    SiftDown(last->scheduleIndex);
+}
+
+void EventMgr::SiftUp(size_t index)
+{
+    ElunaEventProcessor* processor = schedule[index];
+    while (index)
+    {
+        size_t parent = (index - 1) / 2;
+        if (schedule[parent]->nextUpdate <= processor->nextUpdate)
+            break;
+
+        schedule[index] = schedule[parent];
+        schedule[index]->scheduleIndex = index;
+        index = parent;
+    }
+
+    schedule[index] = processor;
+    processor->scheduleIndex = index;
+}
+
+void EventMgr::SiftDown(size_t index)
+{
+    ElunaEventProcessor* processor = schedule[index];
+    for (;;)
+    {
+        size_t child = index * 2 + 1;
+        if (child >= schedule.size())
+            break;
+        if (child + 1 < schedule.size() && schedule[child + 1]->nextUpdate < schedule[child]->nextUpdate)
+            ++child;
+        if (processor->nextUpdate <= schedule[child]->nextUpdate)
+            break;
+
+        schedule[index] = schedule[child];
+        schedule[index]->scheduleIndex = index;
+        index = child;
+    }
+
+    schedule[index] = processor;
+    processor->scheduleIndex = index;
+}
+
 void EventMgr::SetAllEventStates(LuaEventState state)
 {
     for (auto* processor : processors)
@@ -268,9 +627,11 @@ void EventMgr::CleanupObjectProcessors()
         if (it == objectProcessors.end())
             continue;
 
+        // The refs are released, so the coroutines waiting on the object are collected
         ElunaEventProcessor* p = it->second.get();
-        p->SetStates(LUAEVENT_STATE_ERASE);
+        p->SetStates(LUAEVENT_STATE_ABORT);
 
+        Unschedule(p);
         processors.erase(p);
         objectProcessors.erase(it);
     }
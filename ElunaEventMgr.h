@@ -19,7 +19,10 @@
 #include "Util.h"
 #endif
 
+#include <algorithm>
 #include <map>
+#include <memory>
+#include <vector>
 
 #if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
 #include "Define.h"
@@ -54,7 +57,7 @@ enum GlobalEventSpace : uint8
 
 struct LuaEvent
 {
-    LuaEvent(int _funcRef, uint32 _min, uint32 _max, uint32 _repeats) : min(_min), max(_max), delay(0), repeats(_repeats), funcRef(_funcRef), state(LUAEVENT_STATE_RUN) { }
+    LuaEvent(int _funcRef, uint32 _min, uint32 _max, uint32 _repeats) : min(_min), max(_max), delay(0), offset(0), repeats(_repeats), funcRef(_funcRef), state(LUAEVENT_STATE_RUN), coroutine(false), deadline(0), expiry(0), next(nullptr) { }
 
     void SetState(LuaEventState _state)
     {
@@ -70,9 +73,234 @@ struct LuaEvent
     uint32 min;   // Minimum delay between event calls
     uint32 max;   // Maximum delay between event calls
     uint32 delay; // The currently used waiting time
+    uint32 offset; // Extra waiting time before the first call, moves the phase of a repeating event
     uint32 repeats; // Amount of repeats to make, 0 for infinite
     int funcRef;    // Lua function reference ID, also used as event ID
     LuaEventState state;    // State for next call
+
+    bool coroutine;  // funcRef refers to a coroutine waiting in Sleep or WaitUntil instead of a function
+    uint64 deadline; // Processor time a WaitUntil times out at, 0 for none
+
+    uint64 expiry;  // Processor time the event is due at, see ElunaTimingWheel
+    LuaEvent* next; // Next event in the same timing wheel slot
+};
+
+/*
+ * Allocates the LuaEvents of a state from chunks that are kept until the state is closed.
+ *
+ * Freed events are reused before a new chunk is allocated, so timers that are created and finished
+ *   all the time don't go through the global allocator. Events don't move, so pointers to them stay valid.
+ */
+class LuaEventPool
+{
+public:
+    struct Stats
+    {
+        uint64 allocations = 0; // events created in total
+        uint64 frees = 0;       // events destroyed in total
+        uint32 live = 0;        // events that exist now
+        uint32 peak = 0;        // highest amount of events that existed at once
+        uint32 capacity = 0;    // events that fit in the allocated chunks
+    };
+
+    LuaEventPool() : freeList(nullptr) { }
+    LuaEventPool(LuaEventPool const&) = delete;
+    LuaEventPool& operator=(LuaEventPool const&) = delete;
+
+    LuaEvent* Create(int funcRef, uint32 min, uint32 max, uint32 repeats);
+    void Destroy(LuaEvent* luaEvent);
+
+    Stats const& GetStats() const { return stats; }
+
+private:
+    static constexpr uint32 CHUNK_SIZE = 256;
+
+    union Slot
+    {
+        Slot* nextFree;
+        alignas(LuaEvent) unsigned char storage[sizeof(LuaEvent)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    Slot* freeList;
+    Stats stats;
+};
+
+/*
+ * Hierarchical timing wheel of LuaEvents with millisecond resolution.
+ *
+ * The first level has a slot for each of the next 256 milliseconds and each further level
+ *   has 64 slots that each cover a whole rotation of the level below it.
+ * When the first level wraps around, the next slot of the level above is cascaded into the levels below it,
+ *   so inserting an event and expiring it are both O(1).
+ *
+ * Events expire in order of their expiry, events due at the same millisecond in no particular order.
+ */
+class ElunaTimingWheel
+{
+public:
+    ElunaTimingWheel();
+
+    // Adds the event to expire at `expiry`, an expiry that already passed expires on the next Advance
+    void Insert(LuaEvent* luaEvent, uint64 expiry);
+
+    /*
+     * Removes the events due at or before `now` from the wheel and calls `func` with each of them in order of expiry.
+     *
+     * Events inserted by `func` that are due at or before `now` expire on the next Advance.
+     * If `func` returns false the wheel stops there, the due events left expire first on the next Advance.
+     * Returns false if it stopped before all due events expired.
+     */
+    template<typename F>
+    bool Advance(uint64 now, F&& func)
+    {
+        if (!ExpireList(overdue, func))
+            return false;
+
+        while (time <= now && count)
+        {
+            uint32 index = time & LEVEL0_MASK;
+            if (!index)
+                Cascade();
+
+            // Skip to the next occupied slot of the first level, or to the next cascade that can fill it
+            int next = FindOccupiedSlot(index);
+            uint64 slotTime;
+            if (next >= 0)
+                slotTime = time - index + next;
+            else if (IsLevel0Empty())
+                slotTime = GetNextCascade(time + 1);
+            else
+                slotTime = (time | LEVEL0_MASK) + 1;
+
+            if (next < 0 || slotTime > now)
+            {
+                time = std::min(slotTime, now + 1);
+                continue;
+            }
+
+            Slot slot = level0[next];
+            level0[next] = Slot();
+            occupied[next / 64] &= ~(uint64(1) << (next % 64));
+            time = slotTime + 1;
+
+            if (!ExpireList(slot, func))
+                return false;
+        }
+
+        // No events left to expire, so the wheel can skip ahead without cascading
+        if (!count && time <= now)
+            time = now + 1;
+        return true;
+    }
+
+    // Calls `func` with every event in the wheel, `func` may delete the event
+    template<typename F>
+    void ForEach(F&& func)
+    {
+        ForEachInList(overdue, func);
+        for (Slot& slot : level0)
+            ForEachInList(slot, func);
+        for (auto& level : levels)
+            for (Slot& slot : level)
+                ForEachInList(slot, func);
+    }
+
+    // Removes all events from the wheel without deleting them
+    void Clear();
+
+    bool IsEmpty() const { return !count; }
+
+    /*
+     * Returns a time at or before the expiry of the earliest event, or UINT64_MAX if the wheel is empty.
+     * Overdue events have expired already, so the expiry of the first of them is returned.
+     *
+     * Events above the first level only have to be looked at when they are cascaded,
+     *   so Advance needs to be called at the returned time but not before it.
+     */
+    uint64 GetNextExpiry() const;
+
+private:
+    static constexpr uint32 LEVEL0_BITS = 8;
+    static constexpr uint32 LEVEL_BITS = 6;
+    static constexpr uint32 LEVEL0_SIZE = 1 << LEVEL0_BITS;
+    static constexpr uint32 LEVEL_SIZE = 1 << LEVEL_BITS;
+    static constexpr uint32 LEVEL0_MASK = LEVEL0_SIZE - 1;
+    static constexpr uint32 LEVEL_MASK = LEVEL_SIZE - 1;
+    // 8 + 4 * 6 bits cover any uint32 delay
+    static constexpr uint32 LEVEL_COUNT = 4;
+
+    struct Slot
+    {
+        LuaEvent* head = nullptr;
+        LuaEvent* tail = nullptr;
+
+        void Append(LuaEvent* luaEvent)
+        {
+            luaEvent->next = nullptr;
+            if (tail)
+                tail->next = luaEvent;
+            else
+                head = luaEvent;
+            tail = luaEvent;
+        }
+    };
+
+    template<typename F>
+    bool ExpireList(Slot& slot, F& func)
+    {
+        LuaEvent* luaEvent = slot.head;
+        LuaEvent* tail = slot.tail;
+        slot = Slot();
+        while (luaEvent)
+        {
+            LuaEvent* next = luaEvent->next;
+            --count;
+            if (!func(luaEvent))
+            {
+                // The rest of the list is already due, so it goes in front of the overdue events
+                if (next)
+                {
+                    tail->next = overdue.head;
+                    if (!overdue.tail)
+                        overdue.tail = tail;
+                    overdue.head = next;
+                }
+                return false;
+            }
+            luaEvent = next;
+        }
+        return true;
+    }
+
+    template<typename F>
+    static void ForEachInList(Slot& slot, F& func)
+    {
+        for (LuaEvent* luaEvent = slot.head; luaEvent;)
+        {
+            LuaEvent* next = luaEvent->next;
+            func(luaEvent);
+            luaEvent = next;
+        }
+    }
+
+    // Returns the index of the lowest set bit, or -1 if no bit is set
+    static int FindFirstBit(uint64 bits);
+    // Returns the first occupied slot of the first level at or after `index`, or -1
+    int FindOccupiedSlot(uint32 index) const;
+    bool IsLevel0Empty() const;
+    // Returns the first time at or after `from` that an occupied slot of a higher level is cascaded, or UINT64_MAX
+    uint64 GetNextCascade(uint64 from) const;
+    void Cascade();
+    void Place(LuaEvent* luaEvent);
+
+    Slot overdue;
+    Slot level0[LEVEL0_SIZE];
+    Slot levels[LEVEL_COUNT][LEVEL_SIZE];
+    uint64 occupied[LEVEL0_SIZE / 64]; // bitmap of the occupied first level slots
+    uint64 levelOccupied[LEVEL_COUNT]; // bitmaps of the occupied slots of the higher levels
+    uint64 time; // the next millisecond to expire, events due before it have expired
+    size_t count;
 };
 
 class ElunaEventProcessor
@@ -80,18 +308,29 @@ class ElunaEventProcessor
     friend class EventMgr;
 
 public:
-    typedef std::multimap<uint64, LuaEvent*> EventList;
     typedef std::unordered_map<int, LuaEvent*> EventMap;
 
-    ElunaEventProcessor(EventMgr* mgr, WorldObject* obj) : m_time(0), obj(obj), mgr(mgr) { }
+    ElunaEventProcessor(EventMgr* mgr, WorldObject* obj) : obj(obj), mgr(mgr) { }
     ~ElunaEventProcessor();
 
-    void Update(uint32 diff);
+    /*
+     * Runs the events that are due at the current time of the EventMgr, or until the update budget of the state runs out.
+     *
+     * Returns true if the budget ran out before all due events ran.
+     */
+    bool Update();
     // removes all timed events on next tick or at tick end
     void SetStates(LuaEventState state);
     // set the event to be removed when executing
     void SetState(int eventId, LuaEventState state);
-    void AddEvent(int funcRef, uint32 min, uint32 max, uint32 repeats);
+    /*
+     * Adds a timed event, the first call is delayed by a random time up to `jitter` milliseconds.
+     *
+     * Without a jitter, repeating events with a fixed delay are spread over their interval when Eluna.SpreadRepeatingEvents is enabled.
+     */
+    void AddEvent(int funcRef, uint32 min, uint32 max, uint32 repeats, uint32 jitter = 0);
+    // Resumes the coroutine referred by `threadRef` after `delay`, a `timeout` is the longest time a WaitUntil waits
+    void AddCoroutine(int threadRef, uint32 delay, uint32 timeout);
 
 private:
     struct DeferredOp
@@ -111,9 +350,14 @@ private:
     bool isUpdating = false;
     std::vector<DeferredOp> deferredOps;
 
-    EventList eventList;
+    // Created by the first AddEvent, the wheel takes a few kilobytes and most objects never get a timed event
+    std::unique_ptr<ElunaTimingWheel> eventWheel;
     EventMap eventMap;
-    uint64 m_time;
+
+    // Position in the update schedule of the EventMgr and the time it is due at, see EventMgr::Schedule
+    static constexpr size_t NOT_SCHEDULED = SIZE_MAX;
+    size_t scheduleIndex = NOT_SCHEDULED;
+    uint64 nextUpdate = 0;
 
     bool pendingDeletion = false;
 
@@ -147,6 +391,10 @@ public:
     // Global (per state) processors
     ElunaEventProcessor* GetGlobalProcessor(GlobalEventSpace space);
 
+    LuaEventPool::Stats const& GetEventPoolStats() const { return eventPool.GetStats(); }
+    // Amount of processors with due events left over by the last update, see Eluna.TickBudget
+    size_t GetCarriedProcessors() const { return carriedProcessors; }
+
     // Per-object processors
     uint64 CreateObjectProcessor(WorldObject* obj);
     ElunaEventProcessor* GetObjectProcessor(uint64 processorId);
@@ -157,6 +405,9 @@ private:
     typedef std::unordered_map<uint64, std::unique_ptr<ElunaEventProcessor>> ObjectProcessorMap;
     typedef std::unordered_map<GlobalEventSpace, std::unique_ptr<ElunaEventProcessor>> GlobalProcessorsMap;
 
+    // Declared before the processors, so that it outlives them
+    LuaEventPool eventPool;
+
     ProcessorSet processors; // tracks ALL processors (object + global)
     GlobalProcessorsMap globalProcessors;
     ObjectProcessorMap objectProcessors;
@@ -164,7 +415,32 @@ private:
 
     Eluna* E;
 
+    /*
+     * Processors are kept in a min-heap by the time of their next due event,
+     *   so an update only visits the processors that have events due.
+     */
+    std::vector<ElunaEventProcessor*> schedule;
+    std::vector<ElunaEventProcessor*> dueProcessors;
+    uint64 time; // total time passed to UpdateProcessors, the time events are scheduled in
+    size_t carriedProcessors;
+
+    /*
+     * The amount of repeating events given a phase so far, per interval.
+     *
+     * Events of the same interval are spread over it by the bit-reversed count, so the phases stay evenly spaced
+     *   however many events there are, even when they are on different processors.
+     */
+    std::unordered_map<uint32, uint32> spreadCounts;
+
     void CleanupObjectProcessors();
+    // Returns the extra delay that moves the first call of a repeating event of `interval` to the next free phase
+    uint32 GetSpreadOffset(uint32 interval);
+
+    // Adds the processor to the schedule or moves it to the time of its next due event, removes it if it has no events
+    void Schedule(ElunaEventProcessor* processor);
+    void Unschedule(ElunaEventProcessor* processor);
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
 
     friend class ElunaEventProcessor;
     friend class ElunaProcessorInfo;
@@ -0,0 +1,199 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaFFI.h"
+#include "LuaEngine.h"
+#include "ElunaIncludes.h"
+#include "ElunaTemplate.h"
+
+#include <cstring>
+
+#if defined LUAJIT_VERSION
+namespace
+{
+    // The FFI passes the userdata payload, which is the ElunaObject
+    template <typename T>
+    T* GetFFIObject(void* userdata)
+    {
+        ElunaObject* elunaObj = static_cast<ElunaObject*>(userdata);
+        if (!elunaObj || !elunaObj->IsA(ElunaTypeInfo<T>::GetMask()))
+            return NULL;
+
+        return static_cast<T*>(elunaObj->GetObjectIfValid());
+    }
+
+    // Plain C signatures only, so the FFI can call them
+    float GetX(void* userdata)
+    {
+        WorldObject* obj = GetFFIObject<WorldObject>(userdata);
+        return obj ? obj->GetPositionX() : 0.0f;
+    }
+
+    float GetY(void* userdata)
+    {
+        WorldObject* obj = GetFFIObject<WorldObject>(userdata);
+        return obj ? obj->GetPositionY() : 0.0f;
+    }
+
+    float GetZ(void* userdata)
+    {
+        WorldObject* obj = GetFFIObject<WorldObject>(userdata);
+        return obj ? obj->GetPositionZ() : 0.0f;
+    }
+
+    float GetO(void* userdata)
+    {
+        WorldObject* obj = GetFFIObject<WorldObject>(userdata);
+        return obj ? obj->GetOrientation() : 0.0f;
+    }
+
+    uint32 GetEntry(void* userdata)
+    {
+        Object* obj = GetFFIObject<Object>(userdata);
+        return obj ? obj->GetEntry() : 0;
+    }
+
+    uint32 GetGUIDLow(void* userdata)
+    {
+        Object* obj = GetFFIObject<Object>(userdata);
+        if (!obj)
+            return 0;
+
+#if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
+        return obj->GetGUID().GetCounter();
+#else
+        return obj->GetGUIDLow();
+#endif
+    }
+
+    uint32 GetHealth(void* userdata)
+    {
+        Unit* unit = GetFFIObject<Unit>(userdata);
+        return unit ? unit->GetHealth() : 0;
+    }
+
+    uint32 GetMaxHealth(void* userdata)
+    {
+        Unit* unit = GetFFIObject<Unit>(userdata);
+        return unit ? unit->GetMaxHealth() : 0;
+    }
+
+    // powerType -1 is the unit's current power type
+    uint32 GetPower(void* userdata, int32 powerType)
+    {
+        Unit* unit = GetFFIObject<Unit>(userdata);
+        if (!unit)
+            return 0;
+
+        if (powerType == -1)
+#if defined ELUNA_AZEROTHCORE
+            powerType = unit->getPowerType();
+#else
+            powerType = unit->GetPowerType();
+#endif
+
+        if (powerType < 0 || powerType >= int32(MAX_POWERS))
+            return 0;
+
+        return unit->GetPower(Powers(powerType));
+    }
+
+    uint32 GetLevel(void* userdata)
+    {
+        Unit* unit = GetFFIObject<Unit>(userdata);
+        if (!unit)
+            return 0;
+
+#if defined ELUNA_MANGOS
+        return unit->getLevel();
+#else
+        return unit->GetLevel();
+#endif
+    }
+
+    uint32 GetFaction(void* userdata)
+    {
+        Unit* unit = GetFFIObject<Unit>(userdata);
+        if (!unit)
+            return 0;
+
+#if defined ELUNA_MANGOS
+        return unit->getFaction();
+#elif defined ELUNA_VMANGOS
+        return unit->GetFactionTemplateId();
+#else
+        return unit->GetFaction();
+#endif
+    }
+
+    struct FFIGetter
+    {
+        const char* name;
+        const char* ctype;
+        void* func;
+    };
+
+    FFIGetter const getters[] =
+    {
+        { "GetX", "float (*)(void*)", reinterpret_cast<void*>(&GetX) },
+        { "GetY", "float (*)(void*)", reinterpret_cast<void*>(&GetY) },
+        { "GetZ", "float (*)(void*)", reinterpret_cast<void*>(&GetZ) },
+        { "GetO", "float (*)(void*)", reinterpret_cast<void*>(&GetO) },
+        { "GetEntry", "uint32_t (*)(void*)", reinterpret_cast<void*>(&GetEntry) },
+        { "GetGUIDLow", "uint32_t (*)(void*)", reinterpret_cast<void*>(&GetGUIDLow) },
+        { "GetHealth", "uint32_t (*)(void*)", reinterpret_cast<void*>(&GetHealth) },
+        { "GetMaxHealth", "uint32_t (*)(void*)", reinterpret_cast<void*>(&GetMaxHealth) },
+        { "GetPower", "uint32_t (*)(void*, int32_t)", reinterpret_cast<void*>(&GetPower) },
+        { "GetLevel", "uint32_t (*)(void*)", reinterpret_cast<void*>(&GetLevel) },
+        { "GetFaction", "uint32_t (*)(void*)", reinterpret_cast<void*>(&GetFaction) },
+    };
+
+    // Turns the table of { ctype, address } pairs into FFI function pointers
+    const char* bindChunk =
+        "local ffi = require('ffi')\n"
+        "local getters = ...\n"
+        "local M = {}\n"
+        "for name, getter in pairs(getters) do\n"
+        "    M[name] = ffi.cast(getter[1], getter[2])\n"
+        "end\n"
+        "return M\n";
+}
+#endif
+
+void ElunaFFI::Register([[maybe_unused]] Eluna* E)
+{
+#if defined LUAJIT_VERSION
+    lua_State* L = E->L;
+
+    if (luaL_loadbuffer(L, bindChunk, strlen(bindChunk), "ElunaFFI"))
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Failed to load the FFI getters: %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return;
+    }
+
+    lua_newtable(L);
+    for (FFIGetter const& getter : getters)
+    {
+        lua_newtable(L);
+        lua_pushstring(L, getter.ctype);
+        lua_rawseti(L, -2, 1);
+        lua_pushlightuserdata(L, getter.func);
+        lua_rawseti(L, -2, 2);
+        lua_setfield(L, -2, getter.name);
+    }
+
+    // LuaJIT may be built without the FFI
+    if (lua_pcall(L, 1, 1, 0))
+    {
+        ELUNA_LOG_DEBUG("[Eluna]: FFI getters not available: %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return;
+    }
+
+    lua_setglobal(L, "ElunaFFI");
+#endif
+}
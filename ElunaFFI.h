@@ -0,0 +1,26 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_FFI_H
+#define _ELUNA_FFI_H
+
+class Eluna;
+
+/*
+ * Plain C getters for hot read-only properties, callable through the LuaJIT FFI.
+ *
+ * Calls through a lua_CFunction abort LuaJIT traces, FFI calls can be compiled.
+ *   The getters are exposed as the global table `ElunaFFI`, for example
+ *   `ElunaFFI.GetHealth(unit)`. They take the object itself and return 0 if it is
+ *   not valid or not of the expected type, since FFI calls can't raise Lua errors.
+ */
+namespace ElunaFFI
+{
+    // Creates the `ElunaFFI` global, does nothing unless built with LuaJIT and its FFI
+    void Register(Eluna* E);
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaGossipMenu.h"
+#include "ElunaIncludes.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+};
+
+/*
+ * Reads the optional number field `name` of the table at the top of the stack.
+ *
+ * Returns false if the field exists but is not a number.
+ */
+template<typename T>
+static bool GetNumberField(lua_State* L, const char* name, T& value)
+{
+    lua_getfield(L, -1, name);
+    bool valid = lua_isnil(L, -1) || lua_isnumber(L, -1);
+    if (valid && !lua_isnil(L, -1))
+        value = static_cast<T>(lua_tonumber(L, -1));
+    lua_pop(L, 1);
+    return valid;
+}
+
+ElunaGossipMenu::ElunaGossipMenu(ElunaGossipMenu&& other) : L(other.L), pages(std::move(other.pages))
+{
+    other.pages.clear();
+}
+
+ElunaGossipMenu& ElunaGossipMenu::operator=(ElunaGossipMenu&& other)
+{
+    if (this != &other)
+    {
+        Free();
+        L = other.L;
+        pages = std::move(other.pages);
+        other.pages.clear();
+    }
+    return *this;
+}
+
+ElunaGossipMenu::~ElunaGossipMenu()
+{
+    Free();
+}
+
+void ElunaGossipMenu::Free()
+{
+    if (L)
+        for (auto& page : pages)
+            for (auto& item : page.second.items)
+                if (item.callbackRef)
+                    luaL_unref(L, LUA_REGISTRYINDEX, item.callbackRef);
+
+    pages.clear();
+}
+
+const char* ElunaGossipMenu::Load(lua_State* _L, int index)
+{
+    Free();
+    L = _L;
+
+    if (index < 0)
+        index = lua_gettop(L) + index + 1;
+
+    const char* error = NULL;
+
+    lua_pushnil(L);
+    while (!error && lua_next(L, index))
+    {
+        // Stack: menu, pageId, page
+        if (!lua_isnumber(L, -2) || !lua_istable(L, -1))
+        {
+            error = "menu must map page IDs to page tables";
+            lua_pop(L, 1);
+            break;
+        }
+
+        ElunaGossipPage& page = pages[static_cast<uint32>(lua_tonumber(L, -2))];
+        if (!GetNumberField(L, "text", page.npcText))
+            error = "page text must be an npc_text ID";
+
+        lua_getfield(L, -1, "items");
+        // Stack: menu, pageId, page, items
+        if (!error && !lua_istable(L, -1))
+            error = "page items must be a table";
+
+        for (int i = 1; !error; ++i)
+        {
+            lua_rawgeti(L, -1, i);
+            // Stack: menu, pageId, page, items, item
+            if (lua_isnil(L, -1))
+            {
+                lua_pop(L, 1);
+                break;
+            }
+
+            if (!lua_istable(L, -1))
+            {
+                error = "page items must be tables";
+                lua_pop(L, 1);
+                break;
+            }
+
+            page.items.emplace_back();
+            ElunaGossipItem& item = page.items.back();
+            item.questStatus = QUEST_STATUS_INCOMPLETE;
+
+            lua_getfield(L, -1, "text");
+            if (lua_isstring(L, -1))
+                item.text = lua_tostring(L, -1);
+            else
+                error = "item text must be a string";
+            lua_pop(L, 1);
+
+            if (!GetNumberField(L, "icon", item.icon) ||
+                !GetNumberField(L, "level", item.minLevel) ||
+                !GetNumberField(L, "class", item.classId) ||
+                !GetNumberField(L, "money", item.money) ||
+                !GetNumberField(L, "quest", item.questId) ||
+                !GetNumberField(L, "questStatus", item.questStatus) ||
+                !GetNumberField(L, "menu", item.submenu))
+                error = "item icon, conditions and menu must be numbers";
+
+            lua_getfield(L, -1, "callback");
+            if (lua_isfunction(L, -1))
+                item.callbackRef = luaL_ref(L, LUA_REGISTRYINDEX);
+            else
+            {
+                if (!lua_isnil(L, -1))
+                    error = "item callback must be a function";
+                lua_pop(L, 1);
+            }
+
+            lua_getfield(L, -1, "teleport");
+            // Stack: menu, pageId, page, items, item, teleport
+            if (lua_istable(L, -1))
+            {
+                item.teleport = true;
+                if (!GetNumberField(L, "map", item.mapId) ||
+                    !GetNumberField(L, "x", item.x) ||
+                    !GetNumberField(L, "y", item.y) ||
+                    !GetNumberField(L, "z", item.z) ||
+                    !GetNumberField(L, "o", item.o))
+                    error = "item teleport coordinates must be numbers";
+            }
+            else if (!lua_isnil(L, -1))
+                error = "item teleport must be a table";
+            lua_pop(L, 2);
+        }
+
+        lua_pop(L, 2);
+        // Stack: menu, pageId
+    }
+
+    // lua_next was not called again, so the last page ID is still on the stack
+    if (error)
+        lua_pop(L, 1);
+
+    if (!error && !GetPage(ELUNA_GOSSIP_ROOT_PAGE))
+        error = "menu must have a root page with ID 1";
+
+    for (auto& page : pages)
+        for (auto& item : page.second.items)
+            if (!error && item.submenu && !GetPage(item.submenu))
+                error = "item menu must refer to a page of the same menu";
+
+    if (error)
+        Free();
+
+    return error;
+}
+
+const ElunaGossipPage* ElunaGossipMenu::GetPage(uint32 pageId) const
+{
+    auto itr = pages.find(pageId);
+    return itr != pages.end() ? &itr->second : NULL;
+}
+
+const ElunaGossipItem* ElunaGossipMenu::GetItem(uint32 pageId, uint32 itemIndex) const
+{
+    const ElunaGossipPage* page = GetPage(pageId);
+    if (!page || !itemIndex || itemIndex > page->items.size())
+        return NULL;
+
+    return &page->items[itemIndex - 1];
+}
@@ -0,0 +1,91 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_GOSSIP_MENU_H
+#define _ELUNA_GOSSIP_MENU_H
+
+#include "Common.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct lua_State;
+
+// The page shown by OnGossipHello
+#define ELUNA_GOSSIP_ROOT_PAGE 1
+
+/*
+ * A single option of a static gossip page.
+ *
+ * The option is only shown when all of its conditions are met.
+ * When selected, the first action that is set is performed: callback, submenu, teleport.
+ * If none is set, the gossip window is closed.
+ */
+struct ElunaGossipItem
+{
+    uint32 icon = 0;
+    std::string text;
+
+    // Conditions, 0 means the condition is not checked
+    uint32 minLevel = 0;
+    uint32 classId = 0;
+    uint32 money = 0;
+    uint32 questId = 0;
+    uint32 questStatus = 0;
+
+    // Actions
+    int callbackRef = 0;
+    uint32 submenu = 0;
+    bool teleport = false;
+    uint32 mapId = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float o = 0.0f;
+};
+
+struct ElunaGossipPage
+{
+    uint32 npcText = 0;
+    std::vector<ElunaGossipItem> items;
+};
+
+/*
+ * A gossip menu tree registered once from Lua and rendered by the gossip hooks
+ *   without entering Lua, except for callback actions.
+ *
+ * The gossip sender is the page ID and the action is the 1-based option index.
+ */
+class ElunaGossipMenu
+{
+public:
+    ElunaGossipMenu() { }
+    ElunaGossipMenu(ElunaGossipMenu&& other);
+    ElunaGossipMenu& operator=(ElunaGossipMenu&& other);
+    ElunaGossipMenu(ElunaGossipMenu const&) = delete;
+    ElunaGossipMenu& operator=(ElunaGossipMenu const&) = delete;
+    ~ElunaGossipMenu();
+
+    /*
+     * Reads the menu table at `index` of the Lua stack.
+     *
+     * Returns an error message if the table is not a valid menu, otherwise NULL.
+     */
+    const char* Load(lua_State* L, int index);
+
+    const ElunaGossipPage* GetPage(uint32 pageId) const;
+    const ElunaGossipItem* GetItem(uint32 pageId, uint32 itemIndex) const;
+
+private:
+    // Releases the callback references
+    void Free();
+
+    lua_State* L = NULL;
+    std::unordered_map<uint32, ElunaGossipPage> pages;
+};
+
+#endif
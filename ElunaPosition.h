@@ -0,0 +1,75 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_POSITION_H
+#define _ELUNA_POSITION_H
+
+#include <cmath>
+
+/*
+ * Coordinates and orientation passed to and from Lua as a single value.
+ *
+ * The cores all have their own position types, so this is converted to and from their coordinates at the method boundary.
+ */
+struct ElunaPosition
+{
+    float x;
+    float y;
+    float z;
+    float o;
+
+    explicit ElunaPosition(float x = 0.0f, float y = 0.0f, float z = 0.0f, float o = 0.0f) : x(x), y(y), z(z), o(o) { }
+
+    // Arithmetic applies to the coordinates, the orientation of the left operand is kept
+    ElunaPosition operator+(ElunaPosition const& other) const { return ElunaPosition(x + other.x, y + other.y, z + other.z, o); }
+    ElunaPosition operator-(ElunaPosition const& other) const { return ElunaPosition(x - other.x, y - other.y, z - other.z, o); }
+    ElunaPosition operator*(float scale) const { return ElunaPosition(x * scale, y * scale, z * scale, o); }
+    ElunaPosition operator/(float scale) const { return ElunaPosition(x / scale, y / scale, z / scale, o); }
+    ElunaPosition operator-() const { return ElunaPosition(-x, -y, -z, o); }
+
+    bool operator==(ElunaPosition const& other) const { return x == other.x && y == other.y && z == other.z && o == other.o; }
+
+    float GetLength() const { return std::sqrt(x * x + y * y + z * z); }
+
+    float GetDistance(ElunaPosition const& other) const { return (other - *this).GetLength(); }
+
+    float GetDistance2d(ElunaPosition const& other) const
+    {
+        float dx = other.x - x;
+        float dy = other.y - y;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    // Angle from this position to `other` in radians, between 0 and 2 pi
+    float GetAngle(ElunaPosition const& other) const { return NormalizeOrientation(std::atan2(other.y - y, other.x - x)); }
+
+    // Point `dist` yards away at `angle` radians relative to the orientation, at the same height
+    ElunaPosition GetRelativePoint(float dist, float angle) const
+    {
+        float direction = NormalizeOrientation(o + angle);
+        return ElunaPosition(x + dist * std::cos(direction), y + dist * std::sin(direction), z, o);
+    }
+
+    // Interpolates between this position at `t` 0 and `other` at `t` 1, the orientation turns the shorter way around
+    ElunaPosition Lerp(ElunaPosition const& other, float t) const
+    {
+        float turn = NormalizeOrientation(other.o - o);
+        if (turn > PI)
+            turn -= 2.0f * PI;
+
+        return ElunaPosition(x + (other.x - x) * t, y + (other.y - y) * t, z + (other.z - z) * t, NormalizeOrientation(o + turn * t));
+    }
+
+    static float NormalizeOrientation(float o)
+    {
+        o = std::fmod(o, 2.0f * PI);
+        return o < 0.0f ? o + 2.0f * PI : o;
+    }
+
+    static constexpr float PI = 3.14159265358979323846f;
+};
+
+#endif
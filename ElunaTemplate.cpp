@@ -10,6 +10,16 @@
 #include "ElunaTemplate.h"
 #include "ElunaUtility.h"
 
+#include <atomic>
+
+uint8 ElunaTypeRegistry::NextTypeId()
+{
+    static std::atomic<uint8> nextTypeId(0);
+    uint8 id = nextTypeId++;
+    ASSERT(id < ELUNA_MAX_TYPE_IDS);
+    return id;
+}
+
 #if defined TRACKABLE_PTR_NAMESPACE
 ElunaConstrainedObjectRef<Aura> GetWeakPtrFor(Aura const* obj)
 {
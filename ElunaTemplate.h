@@ -18,6 +18,7 @@ extern "C"
 #include "ElunaCompat.h"
 #include "ElunaConfig.h"
 #include "ElunaSpellWrapper.h"
+#include "ElunaTemplateView.h"
 #if !defined ELUNA_CMANGOS
 #include "SharedDefines.h"
 #else
@@ -29,10 +30,83 @@ extern "C"
 #include "UniqueTrackablePtr.h"
 #endif
 
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * Hands out process wide numeric IDs to the registered types.
+ *
+ * There can be at most ELUNA_MAX_TYPE_IDS registered types, since each type
+ *   needs a bit in the ancestor masks.
+ */
+#define ELUNA_MAX_TYPE_IDS 64
+struct ElunaTypeRegistry
+{
+    static uint8 NextTypeId();
+};
+
+// The registered type that T derives from, if any
+template <typename T>
+struct ElunaBaseType
+{
+    typedef void type;
+};
+
+#define MAKE_ELUNA_BASE_TYPE(type, base) \
+template <> \
+struct ElunaBaseType<type> \
+{ \
+    typedef base type; \
+}
+
+MAKE_ELUNA_BASE_TYPE(WorldObject, Object);
+MAKE_ELUNA_BASE_TYPE(Item, Object);
+MAKE_ELUNA_BASE_TYPE(Unit, WorldObject);
+MAKE_ELUNA_BASE_TYPE(GameObject, WorldObject);
+MAKE_ELUNA_BASE_TYPE(Corpse, WorldObject);
+MAKE_ELUNA_BASE_TYPE(Player, Unit);
+MAKE_ELUNA_BASE_TYPE(Creature, Unit);
+
+/*
+ * Numeric type ID and ancestor mask of T.
+ *
+ * The mask has the bit of T and of all of its base types set,
+ *   so an object is a T if its mask contains the bit of T.
+ */
+template <typename T>
+struct ElunaTypeInfo
+{
+    static uint8 GetId()
+    {
+        static const uint8 id = ElunaTypeRegistry::NextTypeId();
+        return id;
+    }
+
+    static uint64 GetMask()
+    {
+        static const uint64 mask = (uint64(1) << GetId()) | ElunaTypeInfo<typename ElunaBaseType<T>::type>::GetMask();
+        return mask;
+    }
+};
+
+template <>
+struct ElunaTypeInfo<void>
+{
+    static uint64 GetMask() { return 0; }
+};
+
 class ElunaObject
 {
 public:
-    ElunaObject(Eluna* E, char const* tname) : E(E), type_name(tname)
+    ElunaObject(Eluna* E, char const* tname, uint8 typeId, uint64 typeMask) : E(E), type_name(tname), type_id(typeId), type_mask(typeMask)
     {
     }
 
@@ -42,8 +116,14 @@ public:
 
     // Get wrapped object pointer
     virtual void* GetObjIfValid() const = 0;
+    // Get wrapped object pointer converted to Object, NULL if the object is not an Object
+    virtual Object* GetObjectIfValid() const { return NULL; }
     // Returns pointer to the wrapped object's type name
     const char* GetTypeName() const { return type_name; }
+    // Returns the numeric ID of the wrapped object's type, see ElunaTypeInfo
+    uint8 GetTypeId() const { return type_id; }
+    // Returns true if the wrapped object's type is or derives from the type with the given ancestor mask
+    bool IsA(uint64 typeMask) const { return (type_mask & typeMask) == typeMask; }
 #if !defined TRACKABLE_PTR_NAMESPACE
     // Invalidates the pointer if it should be invalidated
     virtual void Invalidate() = 0;
@@ -52,6 +132,8 @@ public:
 protected:
     Eluna* E;
     const char* type_name;
+    uint8 type_id;
+    uint64 type_mask;
 };
 
 #if defined TRACKABLE_PTR_NAMESPACE
@@ -90,7 +172,7 @@ class ElunaObjectImpl : public ElunaObject
 {
 public:
 #if defined TRACKABLE_PTR_NAMESPACE
-    ElunaObjectImpl(Eluna* E, T const* obj, char const* tname) : ElunaObject(E, tname), _obj(GetWeakPtrFor(obj))
+    ElunaObjectImpl(Eluna* E, T const* obj, char const* tname) : ElunaObject(E, tname, ElunaTypeInfo<T>::GetId(), ElunaTypeInfo<T>::GetMask()), _obj(GetWeakPtrFor(obj))
     {
     }
 
@@ -103,7 +185,7 @@ public:
         return nullptr;
     }
 #else
-    ElunaObjectImpl(Eluna* E, T* obj, char const* tname) : ElunaObject(E, tname), _obj(obj), callstackid(E->GetCallstackId())
+    ElunaObjectImpl(Eluna* E, T* obj, char const* tname) : ElunaObject(E, tname, ElunaTypeInfo<T>::GetId(), ElunaTypeInfo<T>::GetMask()), _obj(obj), callstackid(E->GetCallstackId())
     {
     }
 
@@ -118,6 +200,14 @@ public:
     void Invalidate() override { callstackid = 1; }
 #endif
 
+    Object* GetObjectIfValid() const override
+    {
+        if constexpr (std::is_base_of_v<Object, T>)
+            return static_cast<T*>(GetObjIfValid());
+        else
+            return NULL;
+    }
+
 private:
 #if defined TRACKABLE_PTR_NAMESPACE
     ElunaConstrainedObjectRef<T> _obj;
@@ -131,7 +221,7 @@ template <typename T>
 class ElunaObjectValueImpl : public ElunaObject
 {
 public:
-    ElunaObjectValueImpl(Eluna* E, T const* obj, char const* tname) : ElunaObject(E, tname), _obj(*obj /*always a copy, what gets passed here might be pointing to something not owned by us*/)
+    ElunaObjectValueImpl(Eluna* E, T const* obj, char const* tname) : ElunaObject(E, tname, ElunaTypeInfo<T>::GetId(), ElunaTypeInfo<T>::GetMask()), _obj(*obj /*always a copy, what gets passed here might be pointing to something not owned by us*/)
     {
     }
 
@@ -145,8 +235,14 @@ private:
     T _obj;
 };
 
+// Value types are copied into their userdata, so they can't be interned by pointer
+template <typename T>
+struct ElunaIsValueType : std::false_type { };
+
 #define MAKE_ELUNA_OBJECT_VALUE_IMPL(type) \
 template <> \
+struct ElunaIsValueType<type> : std::true_type { }; \
+template <> \
 class ElunaObjectImpl<type> : public ElunaObjectValueImpl<type> \
 { \
 public: \
@@ -159,6 +255,9 @@ MAKE_ELUNA_OBJECT_VALUE_IMPL(ObjectGuid);
 MAKE_ELUNA_OBJECT_VALUE_IMPL(WorldPacket);
 MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaQuery);
 MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaSpellInfo);
+MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaItemTemplate);
+MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaCreatureTemplate);
+MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaPosition);
 
 template<typename T = void>
 struct ElunaRegister
@@ -181,6 +280,174 @@ struct ElunaRegister
         : name(name), mfunc(nullptr), regState(state), flags(static_cast<MethodFlags>(flags)) {}
 };
 
+/*
+ * Process-wide, immutable method table of a type, with the methods of its base types flattened in.
+ *
+ * Each SetMethods call extends the state's table of the type with one more method table.
+ *   The extended table is built by the first state and shared by all states that set
+ *   the same method tables in the same order.
+ */
+template<typename T>
+class ElunaMethodTable
+{
+public:
+    ElunaMethodTable() : index(std::vector<std::string>()) { }
+
+    ElunaRegister<T> const* Find(const char* name, size_t len) const
+    {
+        int i = index.Find(name, len);
+        return i >= 0 ? methods[i] : NULL;
+    }
+
+    // Returns this table with the methods of `methodTable` added, methods with the same name are replaced
+    template<typename C, size_t N>
+    ElunaMethodTable const* Extend(ElunaRegister<C> const (&methodTable)[N]) const
+    {
+        std::lock_guard<std::mutex> guard(GetExtendLock());
+
+        std::unique_ptr<ElunaMethodTable>& extended = extensions[methodTable];
+        if (!extended)
+            extended.reset(new ElunaMethodTable(Flatten(reinterpret_cast<ElunaRegister<T> const*>(methodTable), N)));
+        return extended.get();
+    }
+
+private:
+    typedef std::vector<ElunaRegister<T> const*> MethodList;
+
+    // States are created concurrently in multistate mode
+    static std::mutex& GetExtendLock()
+    {
+        static std::mutex extendLock;
+        return extendLock;
+    }
+
+    explicit ElunaMethodTable(MethodList flattened) : methods(std::move(flattened)), index(GetNames(methods)) { }
+
+    MethodList Flatten(ElunaRegister<T> const* methodTable, size_t count) const
+    {
+        MethodList flattened = methods;
+        std::unordered_map<std::string, size_t> positions;
+        for (size_t i = 0; i < flattened.size(); ++i)
+            positions[flattened[i]->name] = i;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto itr = positions.find(methodTable[i].name);
+            if (itr != positions.end())
+                flattened[itr->second] = &methodTable[i];
+            else
+            {
+                positions[methodTable[i].name] = flattened.size();
+                flattened.push_back(&methodTable[i]);
+            }
+        }
+        return flattened;
+    }
+
+    static std::vector<std::string> GetNames(MethodList const& methods)
+    {
+        std::vector<std::string> names;
+        for (ElunaRegister<T> const* method : methods)
+            names.push_back(method->name);
+        return names;
+    }
+
+    MethodList methods;
+    ElunaNameIndex index;
+    // Tables extended from this one, keyed by the added method table
+    mutable std::unordered_map<void const*, std::unique_ptr<ElunaMethodTable>> extensions;
+};
+
+/*
+ * Reads argument `narg` as an A for ElunaTypedMethod.
+ *
+ * Integers of up to 32 bits must be whole numbers within the range of A, so `1.5` or `-1`
+ *   for an uint32 is an error instead of being truncated or wrapped. A lua_Number holds every
+ *   such integer exactly, so the check is the same with Lua 5.1, LuaJIT and Lua 5.2+.
+ *   64-bit integers are read with CHECKVAL, which also accepts the int64 and uint64 userdata.
+ */
+template <typename A>
+A ElunaCheckArg(Eluna* E, int narg)
+{
+    if constexpr (std::is_enum_v<A>)
+        return static_cast<A>(ElunaCheckArg<std::underlying_type_t<A>>(E, narg));
+    else if constexpr (std::is_integral_v<A> && !std::is_same_v<A, bool> && sizeof(A) <= sizeof(int32))
+    {
+        lua_Number value = luaL_checknumber(E->L, narg);
+        if (value != std::floor(value))
+            luaL_argerror(E->L, narg, "integer expected");
+        if (value < static_cast<lua_Number>(std::numeric_limits<A>::min()) || value > static_cast<lua_Number>(std::numeric_limits<A>::max()))
+            luaL_argerror(E->L, narg, "value out of range");
+        return static_cast<A>(value);
+    }
+    else if constexpr (std::is_pointer_v<A> && !std::is_same_v<A, const char*>)
+        return E->CHECKOBJ<std::remove_cv_t<std::remove_pointer_t<A>>>(narg);
+    else
+        return E->CHECKVAL<A>(narg);
+}
+
+// Signature of a function or member function used with ElunaTypedMethod
+template <typename F>
+struct ElunaSignature;
+
+template <typename R, typename... Args>
+struct ElunaSignatureImpl
+{
+    static constexpr size_t ArgCount = sizeof...(Args);
+
+    template <auto Func, typename T, size_t... I>
+    static int Call(Eluna* E, T* obj, std::index_sequence<I...>)
+    {
+        // Braced initialization reads the arguments in order
+        std::tuple<std::decay_t<Args>...> args{ ElunaCheckArg<std::decay_t<Args>>(E, I + 2)... };
+
+        if constexpr (std::is_void_v<R>)
+        {
+            std::invoke(Func, obj, std::get<I>(args)...);
+            return 0;
+        }
+        else if constexpr (std::is_enum_v<std::decay_t<R>>)
+        {
+            E->Push(static_cast<std::underlying_type_t<std::decay_t<R>>>(std::invoke(Func, obj, std::get<I>(args)...)));
+            return 1;
+        }
+        else
+        {
+            E->Push(std::invoke(Func, obj, std::get<I>(args)...));
+            return 1;
+        }
+    }
+};
+
+// R Fn(C* obj, Args...)
+template <typename C, typename R, typename... Args>
+struct ElunaSignature<R(*)(C*, Args...)> : ElunaSignatureImpl<R, Args...> { };
+
+// R C::Fn(Args...)
+template <typename C, typename R, typename... Args>
+struct ElunaSignature<R(C::*)(Args...)> : ElunaSignatureImpl<R, Args...> { };
+
+// R C::Fn(Args...) const
+template <typename C, typename R, typename... Args>
+struct ElunaSignature<R(C::*)(Args...) const> : ElunaSignatureImpl<R, Args...> { };
+
+/*
+ * Method thunk generated from the C++ signature of `Func`, which is either a member function
+ *   of the object or a function that takes the object as its first argument.
+ *
+ * The arguments are read with ElunaCheckArg and the result, if any, is pushed.
+ *   Methods that need optional arguments or several results keep the manual form.
+ *
+ *     { "GetEntry", &ElunaTypedMethod<&LuaObject::GetEntry> },       // uint32 GetEntry(Object* obj)
+ *     { "HasFlag", &ElunaTypedMethod<&LuaObject::HasFlag> },         // bool HasFlag(Object* obj, uint16 index, uint32 flag)
+ */
+template <auto Func, typename T>
+int ElunaTypedMethod(Eluna* E, T* obj)
+{
+    typedef ElunaSignature<decltype(Func)> Signature;
+    return Signature::template Call<Func>(E, obj, std::make_index_sequence<Signature::ArgCount>());
+}
+
 template<typename T = void>
 class ElunaTemplate
 {
@@ -223,7 +490,6 @@ public:
         lua_pushcfunction(L, CollectGarbage);
         lua_setfield(L, metatable, "__gc");
 
-        // TODO: Safe to remove this?
         // make methods accessible through metatable
         lua_pushvalue(L, metatable);
         lua_setfield(L, metatable, "__index");
@@ -284,10 +550,23 @@ public:
         lua_pushcfunction(L, GetType);
         lua_setfield(L, metatable, "GetObjectType");
 
+        // methods that are not in the metatable yet are resolved from the type's method table
+        static ElunaMethodTable<T> const emptyMethods;
+        lua_createtable(L, 0, 1);
+        PushIndexMethod(L, metatable, &emptyMethods);
+        lua_setfield(L, -2, "__index");
+        lua_setmetatable(L, metatable);
+
         // pop metatable
         lua_pop(L, 1);
     }
 
+    /*
+     * Adds the methods to the type, or to the global table for global methods.
+     *
+     * Class methods are added to the type's process-wide method table and resolved to closures
+     *   the first time they are used in a state, so setting them costs the state almost nothing.
+     */
     template<typename C, size_t N>
     static void SetMethods(Eluna* E, ElunaRegister<C> const (&methodTable)[N])
     {
@@ -302,6 +581,13 @@ public:
         if constexpr (isGlobal)
         {
             lua_pushglobaltable(L);
+            for (std::size_t i = 0; i < N; i++)
+            {
+                lua_pushstring(L, methodTable[i].name);
+                PushMethod(L, E, &methodTable[i]);
+                lua_rawset(L, -3);
+            }
+            lua_pop(L, 1);
         }
         else
         {
@@ -311,65 +597,64 @@ public:
             lua_pushstring(L, tname);
             lua_rawget(L, LUA_REGISTRYINDEX);
             ASSERT(lua_istable(L, -1));
-        }
+            int metatable = lua_gettop(L);
 
-        // load all core-specific methods
-        for (std::size_t i = 0; i < N; i++)
-        {
-            const auto& method = methodTable + i;
+            // Stack: metatable, method resolver
+            lua_getmetatable(L, metatable);
+            lua_getfield(L, -1, "__index");
+            lua_getupvalue(L, -1, 1);
+            ElunaMethodTable<T> const* methods = static_cast<ElunaMethodTable<T> const*>(lua_touserdata(L, -1));
+            lua_pop(L, 2);
 
-            // push the method name to the Lua stack
-            lua_pushstring(L, method->name);
+            PushIndexMethod(L, metatable, methods->Extend(methodTable));
+            lua_setfield(L, -2, "__index");
+            lua_pop(L, 1);
 
-            // if the method should not be registered, push a closure to error output function
-            if (method->regState == METHOD_REG_NONE)
+            // metamethods are looked up without __index, so they have to be in the metatable
+            for (std::size_t i = 0; i < N; i++)
             {
-                lua_pushstring(L, method->name);
-                lua_pushcclosure(L, MethodUnimpl, 1);
-                lua_rawset(L, -3);
-                continue;
-            }
+                if (strncmp(methodTable[i].name, "__", 2) != 0)
+                    continue;
 
-            // if the method is considered unsafe, and unsafe methods have not been enabled, push a closure to error output function
-            if (method->flags & METHOD_FLAG_UNSAFE && !sElunaConfig->UnsafeMethodsEnabled())
-            {
-                lua_pushstring(L, method->name);
-                lua_pushcclosure(L, MethodUnsafe, 1);
-                lua_rawset(L, -3);
-                continue;
+                lua_pushstring(L, methodTable[i].name);
+                PushMethod(L, E, reinterpret_cast<ElunaRegister<T> const*>(&methodTable[i]));
+                lua_rawset(L, metatable);
             }
 
-            // if the method is considered deprecated, and deprecated methods have not been enabled, push a closure to error output function
-            if (method->flags & METHOD_FLAG_DEPRECATED && !sElunaConfig->DeprecatedMethodsEnabled())
-            {
-                lua_pushstring(L, method->name);
-                lua_pushcclosure(L, MethodDeprecated, 1);
-                lua_rawset(L, -3);
-                continue;
-            }
+            lua_pop(L, 1);
+        }
+    }
 
-            // if we're in multistate mode, we need to check whether a method is flagged as a world or a map specific method
-            if (method->regState != METHOD_REG_ALL)
-            {
-                int32 mapId = E->GetBoundMapId();
-
-                // if the method should not be registered, push a closure to error output function
-                if ((mapId == -1 && method->regState == METHOD_REG_MAP) ||
-                    (mapId != -1 && method->regState == METHOD_REG_WORLD))
-                {
-                    lua_pushstring(L, method->name);
-                    lua_pushinteger(L, mapId);
-                    lua_pushcclosure(L, MethodWrongState, 2);
-                    lua_rawset(L, -3);
-                    continue;
-                }
-            }
+    // Returns the lookup table of the fields, built on first use and shared by all states
+    template<size_t N>
+    static ElunaFieldTable<T> const& GetFieldTable(ElunaField<T> const (&fieldTable)[N])
+    {
+        static ElunaFieldTable<T> const table(fieldTable);
+        return table;
+    }
 
-            // push a closure to the thunk with the method pointer as light user data
-            lua_pushlightuserdata(L, (void*)method);
-            lua_pushcclosure(L, thunk, 1);
-            lua_rawset(L, -3);
-        }
+    /*
+     * Makes the fields readable as `obj.name` through a single __index function.
+     *
+     * Keys that are not fields are looked up from the metatable, so methods keep working.
+     */
+    template<size_t N>
+    static void SetFields(Eluna* E, ElunaField<T> const (&fieldTable)[N])
+    {
+        ASSERT(E);
+        ASSERT(tname);
+
+        lua_State* L = E->L;
+
+        // get metatable
+        lua_pushstring(L, tname);
+        lua_rawget(L, LUA_REGISTRYINDEX);
+        ASSERT(lua_istable(L, -1));
+
+        lua_pushlightuserdata(L, const_cast<ElunaFieldTable<T>*>(&GetFieldTable(fieldTable)));
+        lua_pushvalue(L, -2);
+        lua_pushcclosure(L, IndexField, 2);
+        lua_setfield(L, -2, "__index");
 
         lua_pop(L, 1);
     }
@@ -385,6 +670,11 @@ public:
 
         typedef ElunaObjectImpl<T> ElunaObjectType;
 
+        // Reuse the userdata if the same object was already pushed
+        if constexpr (!ElunaIsValueType<T>::value)
+            if (E->PushInternedObject(obj, tname))
+                return 1;
+
         // Create new userdata
         ElunaObjectType* elunaObject = static_cast<ElunaObjectType*>(lua_newuserdata(L, sizeof(ElunaObjectType)));
         if (!elunaObject)
@@ -406,6 +696,9 @@ public:
             return 1;
         }
         lua_setmetatable(L, -2);
+
+        if constexpr (!ElunaIsValueType<T>::value)
+            E->InternObject(obj);
         return 1;
     }
 
@@ -413,11 +706,16 @@ public:
     {
         lua_State* L = E->L;
 
-        ElunaObject* elunaObj = E->CHECKTYPE(narg, tname, error);
+        ElunaObject* elunaObj = E->CHECKTYPE(narg, tname, ElunaTypeInfo<T>::GetMask(), error);
         if (!elunaObj)
             return NULL;
 
-        void* obj = elunaObj->GetObjIfValid();
+        // A derived type's pointer has to be adjusted through Object, not reinterpreted
+        void* obj;
+        if constexpr (std::is_base_of_v<Object, T>)
+            obj = static_cast<T*>(elunaObj->GetObjectIfValid());
+        else
+            obj = elunaObj->GetObjIfValid();
         if (!obj)
         {
             char buff[256];
@@ -435,6 +733,111 @@ public:
         return static_cast<T*>(obj);
     }
 
+    // Pushes the closure that calls the method in this state, or one that raises why it can't be called
+    template<typename C>
+    static void PushMethod(lua_State* L, Eluna* E, ElunaRegister<C> const* method)
+    {
+        // if the method should not be registered, push a closure to error output function
+        if (method->regState == METHOD_REG_NONE)
+        {
+            lua_pushstring(L, method->name);
+            lua_pushcclosure(L, MethodUnimpl, 1);
+            return;
+        }
+
+        // if the method is considered unsafe, and unsafe methods have not been enabled, push a closure to error output function
+        if (method->flags & METHOD_FLAG_UNSAFE && !sElunaConfig->UnsafeMethodsEnabled())
+        {
+            lua_pushstring(L, method->name);
+            lua_pushcclosure(L, MethodUnsafe, 1);
+            return;
+        }
+
+        // if the method is considered deprecated, and deprecated methods have not been enabled, push a closure to error output function
+        if (method->flags & METHOD_FLAG_DEPRECATED && !sElunaConfig->DeprecatedMethodsEnabled())
+        {
+            lua_pushstring(L, method->name);
+            lua_pushcclosure(L, MethodDeprecated, 1);
+            return;
+        }
+
+        // if we're in multistate mode, we need to check whether a method is flagged as a world or a map specific method
+        if (method->regState != METHOD_REG_ALL)
+        {
+            int32 mapId = E->GetBoundMapId();
+
+            // if the method should not be registered, push a closure to error output function
+            if ((mapId == -1 && method->regState == METHOD_REG_MAP) ||
+                (mapId != -1 && method->regState == METHOD_REG_WORLD))
+            {
+                lua_pushstring(L, method->name);
+                lua_pushinteger(L, mapId);
+                lua_pushcclosure(L, MethodWrongState, 2);
+                return;
+            }
+        }
+
+        // push a closure to the thunk with the method pointer and the Eluna pointer as light user data
+        lua_pushlightuserdata(L, (void*)method);
+        lua_pushlightuserdata(L, E);
+        lua_pushcclosure(L, thunk, 2);
+    }
+
+    static void PushIndexMethod(lua_State* L, int metatable, ElunaMethodTable<T> const* methods)
+    {
+        lua_pushlightuserdata(L, const_cast<ElunaMethodTable<T>*>(methods));
+        lua_pushvalue(L, metatable);
+        lua_pushcclosure(L, IndexMethod, 2);
+    }
+
+    // __index of the metatable's own metatable, called for names that are not in the metatable yet
+    static int IndexMethod(lua_State* L)
+    {
+        if (lua_type(L, 2) != LUA_TSTRING)
+            return 0;
+
+        ElunaMethodTable<T> const* methods = static_cast<ElunaMethodTable<T> const*>(lua_touserdata(L, lua_upvalueindex(1)));
+
+        size_t len;
+        const char* name = lua_tolstring(L, 2, &len);
+        ElunaRegister<T> const* method = methods->Find(name, len);
+        if (!method)
+            return 0;
+
+        PushMethod(L, Eluna::GetEluna(L), method);
+
+        // store the closure in the metatable, so the method is resolved once per state
+        lua_pushvalue(L, 2);
+        lua_pushvalue(L, -2);
+        lua_rawset(L, lua_upvalueindex(2));
+        return 1;
+    }
+
+    static int IndexField(lua_State* L)
+    {
+        if (lua_type(L, 2) == LUA_TSTRING)
+        {
+            ElunaFieldTable<T> const* table = static_cast<ElunaFieldTable<T> const*>(lua_touserdata(L, lua_upvalueindex(1)));
+
+            size_t len;
+            const char* key = lua_tolstring(L, 2, &len);
+            if (ElunaField<T> const* field = table->Find(key, len))
+            {
+                Eluna* E = Eluna::GetEluna(L);
+                T* obj = E->CHECKOBJ<T>(1);
+                if (!obj)
+                    return 0;
+
+                field->push(E, obj);
+                return 1;
+            }
+        }
+
+        lua_pushvalue(L, 2);
+        lua_gettable(L, lua_upvalueindex(2));
+        return 1;
+    }
+
     static int GetType(lua_State* L)
     {
         lua_pushstring(L, tname);
@@ -444,7 +847,7 @@ public:
     static int thunk(lua_State* L)
     {
         ElunaRegister<T>* l = static_cast<ElunaRegister<T>*>(lua_touserdata(L, lua_upvalueindex(1)));
-        Eluna* E = Eluna::GetEluna(L);
+        Eluna* E = static_cast<Eluna*>(lua_touserdata(L, lua_upvalueindex(2)));
 
         // determine if the method table functions are global or non-global
         constexpr bool isGlobal = std::is_same_v<T, void>;
@@ -460,12 +863,19 @@ public:
 
         int top = lua_gettop(L);
 
+        // calls that raise a Lua error are not recorded
+        bool profiling = E->IsMethodProfiling();
+        uint64 startTime = profiling ? ElunaUtil::GetCurrTimeNs() : 0;
+
         int expected = 0;
         if constexpr (isGlobal)
             expected = l->mfunc(E);      // global method
         else
             expected = l->mfunc(E, obj); // non-global method
 
+        if (profiling)
+            E->RecordMethodCall(l, tname ? tname : "Global", l->name, ElunaUtil::GetCurrTimeNs() - startTime);
+
         int args = lua_gettop(L) - top;
         if (args < 0 || args > expected)
         {
@@ -522,4 +932,26 @@ public:
 
 template<typename T> const char* ElunaTemplate<T>::tname = NULL;
 
+template<typename T>
+void Eluna::PushTemplateView(T const* tmpl)
+{
+    if (!tmpl)
+    {
+        Push();
+        return;
+    }
+
+    auto itr = templateViewRefs.find(tmpl);
+    if (itr != templateViewRefs.end())
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, itr->second);
+        return;
+    }
+
+    ElunaTemplateView<T> view(tmpl);
+    ElunaTemplate<ElunaTemplateView<T>>::Push(this, &view);
+    lua_pushvalue(L, -1);
+    templateViewRefs[tmpl] = luaL_ref(L, LUA_REGISTRYINDEX);
+}
+
 #endif
@@ -0,0 +1,69 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaTemplateView.h"
+#include "ElunaIncludes.h"
+
+#include <algorithm>
+
+ElunaNameIndex::ElunaNameIndex(std::vector<std::string> fieldNames) : names(std::move(fieldNames))
+{
+    // Twice as many slots as names keeps the seed search of each bucket short
+    size_t slotCount = 1;
+    while (slotCount < names.size() * 2)
+        slotCount <<= 1;
+    size_t bucketCount = 1;
+    while (bucketCount * 2 < names.size())
+        bucketCount <<= 1;
+
+    std::vector<std::vector<int>> buckets(bucketCount);
+    for (size_t i = 0; i < names.size(); ++i)
+        buckets[Hash(names[i].c_str(), names[i].size(), 0) & (bucketCount - 1)].push_back(static_cast<int>(i));
+
+    // The largest buckets are placed first, while most slots are still free
+    std::vector<size_t> order(bucketCount);
+    for (size_t i = 0; i < bucketCount; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    seeds.assign(bucketCount, 0);
+    slots.assign(slotCount, -1);
+    std::vector<size_t> placed;
+    for (size_t bucket : order)
+    {
+        std::vector<int> const& members = buckets[bucket];
+        if (members.empty())
+            break;
+
+        for (uint32 seed = 1; ; ++seed)
+        {
+            // Only duplicated names can't get a slot of their own
+            ASSERT(seed < (1u << 20));
+
+            placed.clear();
+            for (int index : members)
+            {
+                size_t slot = Hash(names[index].c_str(), names[index].size(), seed) & (slotCount - 1);
+                if (slots[slot] >= 0)
+                    break;
+                slots[slot] = index;
+                placed.push_back(slot);
+            }
+
+            if (placed.size() == members.size())
+            {
+                seeds[bucket] = seed;
+                break;
+            }
+
+            for (size_t slot : placed)
+                slots[slot] = -1;
+        }
+    }
+
+    for (size_t i = 0; i < names.size(); ++i)
+        ASSERT(Find(names[i].c_str(), names[i].size()) == static_cast<int>(i));
+}
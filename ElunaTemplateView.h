@@ -0,0 +1,230 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_TEMPLATE_VIEW_H
+#define _ELUNA_TEMPLATE_VIEW_H
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+};
+#include "LuaEngine.h"
+
+#include <string>
+#include <vector>
+
+/*
+ * Read-only view of a template that is loaded once and not changed afterwards,
+ *   such as an item or creature template.
+ *
+ * Views are pushed with Eluna::PushTemplateView, which shares one userdata per template.
+ */
+template<typename T>
+class ElunaTemplateView
+{
+private:
+    T const* _template;
+public:
+    explicit ElunaTemplateView(T const* tmpl) : _template(tmpl) { }
+    T const* Get() const { return _template; }
+};
+
+typedef ElunaTemplateView<ItemTemplate> ElunaItemTemplate;
+typedef ElunaTemplateView<CreatureTemplate> ElunaCreatureTemplate;
+
+/*
+ * A field of a type that is read from Lua as `obj.name`.
+ *
+ * `value` returns the field as an integer for filters, it is NULL for fields that can't be filtered by.
+ */
+template<typename T>
+struct ElunaField
+{
+    const char* name;
+    void (*push)(Eluna* E, T const* obj);
+    int64 (*value)(T const* obj);
+};
+
+// Field whose value is pushed as is and can be filtered by, `obj` is the object in `expr`
+#define ELUNA_FIELD(type, name, expr) \
+    { name, [](Eluna* E, type const* obj) { E->Push(expr); }, [](type const* obj) { return static_cast<int64>(expr); } }
+
+// Field with a string value that stays at the same address, see Eluna::PushCachedString
+#define ELUNA_STRING_FIELD(type, name, expr) \
+    { name, [](Eluna* E, type const* obj) { E->PushCachedString(expr); }, NULL }
+
+/*
+ * Perfect hash of a fixed set of names.
+ *
+ * The names are hashed into buckets, and for each bucket a seed is searched when the set is built
+ *   so that every name of the bucket gets its own slot (hash and displace).
+ *   A lookup hashes the key twice and compares it with at most one name.
+ */
+class ElunaNameIndex
+{
+public:
+    explicit ElunaNameIndex(std::vector<std::string> names);
+
+    // Returns the position of the name in the set, or -1 if it is not in the set
+    int Find(const char* name, size_t len) const
+    {
+        uint32 seed = seeds[Hash(name, len, 0) & (seeds.size() - 1)];
+        int index = slots[Hash(name, len, seed) & (slots.size() - 1)];
+        if (index < 0 || names[index].size() != len || names[index].compare(0, len, name, len) != 0)
+            return -1;
+        return index;
+    }
+
+private:
+    static uint32 Hash(const char* name, size_t len, uint32 seed)
+    {
+        uint32 hash = 2166136261u ^ (seed * 2654435761u);
+        for (size_t i = 0; i < len; ++i)
+        {
+            hash ^= static_cast<uint8>(name[i]);
+            hash *= 16777619u;
+        }
+
+        // FNV only carries the low bits upwards, so the bits are mixed down before they are masked
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        return hash ^ (hash >> 16);
+    }
+
+    std::vector<std::string> names;
+    std::vector<uint32> seeds; // seed of each bucket
+    std::vector<int> slots;
+};
+
+template<typename T>
+class ElunaFieldTable
+{
+public:
+    template<size_t N>
+    explicit ElunaFieldTable(ElunaField<T> const (&fieldTable)[N]) : fields(fieldTable), index(GetNames(fieldTable))
+    {
+    }
+
+    ElunaField<T> const* Find(const char* name, size_t len) const
+    {
+        int i = index.Find(name, len);
+        return i >= 0 ? &fields[i] : NULL;
+    }
+
+private:
+    template<size_t N>
+    static std::vector<std::string> GetNames(ElunaField<T> const (&fieldTable)[N])
+    {
+        std::vector<std::string> names;
+        for (ElunaField<T> const& field : fieldTable)
+            names.push_back(field.name);
+        return names;
+    }
+
+    ElunaField<T> const* fields;
+    ElunaNameIndex index;
+};
+
+/*
+ * Matches objects against the field values of a Lua filter table.
+ *
+ * Each filter field maps to either a value or an inclusive `{ min, max }` range,
+ *   and an object matches when all of its fields match.
+ */
+template<typename T>
+class ElunaFieldFilter
+{
+public:
+    /*
+     * Reads the filter table at `index` of the Lua stack, nil is an empty filter.
+     *
+     * Returns an error message if the table is not a valid filter, otherwise NULL.
+     */
+    const char* Load(lua_State* L, int index, ElunaFieldTable<T> const& table)
+    {
+        terms.clear();
+        if (lua_isnoneornil(L, index))
+            return NULL;
+        if (!lua_istable(L, index))
+            return "filter must be a table";
+
+        if (index < 0)
+            index = lua_gettop(L) + index + 1;
+
+        const char* error = NULL;
+
+        lua_pushnil(L);
+        while (!error && lua_next(L, index))
+        {
+            // Stack: filter, name, value
+            size_t len = 0;
+            const char* name = lua_type(L, -2) == LUA_TSTRING ? lua_tolstring(L, -2, &len) : NULL;
+            ElunaField<T> const* field = name ? table.Find(name, len) : NULL;
+
+            Term term;
+            term.field = field;
+            if (!field || !field->value)
+                error = "filter fields must be names of fields that can be filtered by";
+            else if (lua_isnumber(L, -1))
+                term.min = term.max = static_cast<int64>(lua_tonumber(L, -1));
+            else if (lua_istable(L, -1))
+            {
+                lua_rawgeti(L, -1, 1);
+                lua_rawgeti(L, -2, 2);
+                // Stack: filter, name, range, min, max
+                if (lua_isnumber(L, -2) && lua_isnumber(L, -1))
+                {
+                    term.min = static_cast<int64>(lua_tonumber(L, -2));
+                    term.max = static_cast<int64>(lua_tonumber(L, -1));
+                }
+                else
+                    error = "filter ranges must be { min, max } numbers";
+                lua_pop(L, 2);
+            }
+            else
+                error = "filter values must be numbers or { min, max } ranges";
+
+            if (!error)
+                terms.push_back(term);
+            lua_pop(L, 1);
+        }
+
+        // lua_next was not called again, so the last name is still on the stack
+        if (error)
+        {
+            lua_pop(L, 1);
+            terms.clear();
+        }
+
+        return error;
+    }
+
+    bool Matches(T const* obj) const
+    {
+        for (Term const& term : terms)
+        {
+            int64 value = term.field->value(obj);
+            if (value < term.min || value > term.max)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    struct Term
+    {
+        ElunaField<T> const* field;
+        int64 min;
+        int64 max;
+    };
+
+    std::vector<Term> terms;
+};
+
+#endif
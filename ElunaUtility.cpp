@@ -19,6 +19,7 @@
 #include "Server/DBCStores.h"
 #include "Util/Timer.h"
 #endif
+#include <chrono>
 
 uint32 ElunaUtil::GetCurrTime()
 {
@@ -29,6 +30,16 @@ uint32 ElunaUtil::GetCurrTime()
 #endif
 }
 
+uint64 ElunaUtil::GetCurrTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64 ElunaUtil::GetCurrTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 uint32 ElunaUtil::GetTimeDiff(uint32 oldMSTime)
 {
 #if defined ELUNA_TRINITY || defined ELUNA_MANGOS  || defined ELUNA_AZEROTHCORE
@@ -144,6 +144,12 @@ namespace ElunaUtil
 
     uint32 GetTimeDiff(uint32 oldMSTime);
 
+    // Monotonic time in microseconds, for measuring short Lua calls
+    uint64 GetCurrTimeUs();
+
+    // Monotonic time in nanoseconds, for measuring bound method calls
+    uint64 GetCurrTimeNs();
+
     class ObjectGUIDCheck
     {
     public:
@@ -10,6 +10,7 @@
 #include "ElunaCompat.h"
 #include "ElunaConfig.h"
 #include "ElunaEventMgr.h"
+#include "ElunaFFI.h"
 #include "ElunaIncludes.h"
 #include "ElunaLoader.h"
 #include "ElunaTemplate.h"
@@ -17,6 +18,9 @@
 #include "ElunaCreatureAI.h"
 #include "ElunaInstanceAI.h"
 
+#include <algorithm>
+#include <fstream>
+
 extern "C"
 {
 // Base lua libraries
@@ -38,6 +42,10 @@ void Eluna::_ReloadEluna()
     // Cancel all pending async queries
     GetQueryProcessor().CancelAll();
 #endif
+#if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
+    // The function refs of the queued callbacks are released with the state
+    queryCallbacks.clear();
+#endif
 
     // Close lua
     CloseLua();
@@ -54,7 +62,22 @@ void Eluna::_ReloadEluna()
 Eluna::Eluna(Map* map) :
 event_level(0),
 push_counter(0),
+tickLuaTime(0),
+lastTickLuaTime(0),
+shedPriority(Hooks::BINDING_PRIORITY_COUNT),
+overrunTicks(0),
+shedCalls(),
+updateStartTime(0),
+updateCalls(0),
+updateBudgetSpent(false),
+carryOverTicks(0),
+maxCarriedProcessors(0),
+maxCarriedCallbacks(0),
+methodProfiling(sElunaConfig->IsMethodProfilingEnabled()),
 boundMap(map),
+objectCacheRef(LUA_NOREF),
+outermostCalls(0),
+objectCacheCall(0),
 L(NULL)
 {
     OpenLua();
@@ -77,6 +100,7 @@ void Eluna::CloseLua()
     OnLuaStateClose();
 
     DestroyBindStores();
+    gossipMenus.clear();
 
     // Must close lua state after deleting stores and mgr
     if (L)
@@ -85,6 +109,65 @@ void Eluna::CloseLua()
 
     instanceDataRefs.clear();
     continentDataRefs.clear();
+    playerZones.clear();
+    stringCache.fill(CachedString());
+    spellInfoRefs.clear();
+    templateViewRefs.clear();
+}
+
+// Pushed first by Sleep and WaitUntil, so their yields are told apart from a plain coroutine.yield with any values
+static char CoroutineWaitMarker;
+
+// Only the coroutine the scheduler is resuming can wait, Eluna::L refers to it while it runs
+static bool IsSchedulerCoroutine(lua_State* L)
+{
+    bool isMain = lua_pushthread(L) != 0;
+    lua_pop(L, 1);
+    return !isMain && Eluna::GetEluna(L)->L == L;
+}
+
+// Sleep(ms): suspends the coroutine for `ms` milliseconds
+static int CoroutineSleep(lua_State* L)
+{
+    lua_Number delay = luaL_checknumber(L, 1);
+    luaL_argcheck(L, delay >= 0 && delay <= UINT32_MAX, 1, "delay out of range");
+    if (!IsSchedulerCoroutine(L))
+        return luaL_error(L, "Sleep can only be called from a coroutine started with StartCoroutine");
+
+    lua_settop(L, 1);
+    lua_pushlightuserdata(L, &CoroutineWaitMarker);
+    lua_insert(L, 1);
+    return lua_yield(L, 2);
+}
+
+// WaitUntil(predicate[, timeout[, interval]]): suspends the coroutine until `predicate` returns true or `timeout` milliseconds pass
+static int CoroutineWaitUntil(lua_State* L)
+{
+    luaL_checktype(L, 1, LUA_TFUNCTION);
+    lua_Number timeout = luaL_optnumber(L, 2, 0);
+    lua_Number interval = luaL_optnumber(L, 3, 0);
+    luaL_argcheck(L, timeout >= 0 && timeout <= UINT32_MAX, 2, "timeout out of range");
+    luaL_argcheck(L, interval >= 0 && interval <= UINT32_MAX, 3, "interval out of range");
+    if (!IsSchedulerCoroutine(L))
+        return luaL_error(L, "WaitUntil can only be called from a coroutine started with StartCoroutine");
+
+    // No need to wait if the predicate already holds
+    lua_pushvalue(L, 1);
+    lua_call(L, 0, 1);
+    if (lua_toboolean(L, -1))
+    {
+        lua_pushboolean(L, 1);
+        return 1;
+    }
+
+    lua_settop(L, 3);
+    lua_pushnumber(L, timeout);
+    lua_replace(L, 2);
+    lua_pushnumber(L, interval);
+    lua_replace(L, 3);
+    lua_pushlightuserdata(L, &CoroutineWaitMarker);
+    lua_insert(L, 1);
+    return lua_yield(L, 4);
 }
 
 static int PrecompiledLoader(lua_State* L)
@@ -115,9 +198,21 @@ void Eluna::OpenLua()
 {
     L = luaL_newstate();
 
+#if LUA_VERSION_NUM >= 503
+    static_assert(LUA_EXTRASPACE >= sizeof(Eluna*), "Lua extra space can't hold the Eluna pointer");
+    *static_cast<Eluna**>(lua_getextraspace(L)) = this;
+#endif
     lua_pushlightuserdata(L, this);
     lua_setfield(L, LUA_REGISTRYINDEX, ELUNA_STATE_PTR);
 
+    // Weak valued so interned userdata is still collected once Lua drops it
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushstring(L, "v");
+    lua_setfield(L, -2, "__mode");
+    lua_setmetatable(L, -2);
+    objectCacheRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
     CreateBindStores();
 
     // open base lua libraries
@@ -125,10 +220,15 @@ void Eluna::OpenLua()
 
     // Register methods and functions
     RegisterMethods(this);
+    ElunaFFI::Register(this);
 
     // Register event ID lookup table
     RegisterHookGlobals(L);
 
+    // Yielding from a method would skip the end of its thunk, so the coroutine waits are plain C functions
+    lua_register(L, "Sleep", &CoroutineSleep);
+    lua_register(L, "WaitUntil", &CoroutineWaitUntil);
+
     // get require paths
     const std::string& requirepath = sElunaLoader->GetRequirePath();
     const std::string& requirecpath = sElunaLoader->GetRequireCPath();
@@ -179,6 +279,7 @@ void Eluna::CreateBindStores()
     CreateBinding<EntryKey<Hooks::GossipEvents>>(Hooks::REGTYPE_PLAYER_GOSSIP);
     CreateBinding<EntryKey<Hooks::InstanceEvents>>(Hooks::REGTYPE_MAP);
     CreateBinding<EntryKey<Hooks::InstanceEvents>>(Hooks::REGTYPE_INSTANCE);
+    CreateBinding<EntryKey<Hooks::PlayerEvents>>(Hooks::REGTYPE_PLAYER_ENTRY);
 
     CreateBinding<UniqueObjectKey<Hooks::CreatureEvents>>(Hooks::REGTYPE_CREATURE_UNIQUE);
 }
@@ -207,6 +308,15 @@ void Eluna::RegisterHookGlobals(lua_State* _L)
         lua_setfield(_L, -2, hs.category); // events[category] = subtable
     }
     lua_setglobal(_L, "events");
+
+    const HookStorage& priorities = Hooks::BindingPriorityStorage;
+    lua_newtable(_L);
+    for (size_t i = 0; i < priorities.eventCount; ++i)
+    {
+        lua_pushinteger(_L, priorities.events[i].id);
+        lua_setfield(_L, -2, priorities.events[i].name);
+    }
+    lua_setglobal(_L, priorities.category);
 }
 
 void Eluna::RunScripts()
@@ -308,6 +418,78 @@ int Eluna::StackTrace(lua_State* _L)
     return 1;
 }
 
+void Eluna::StartCoroutine(ElunaEventProcessor* processor, int narg)
+{
+    int nargs = lua_gettop(L) - narg;
+
+    lua_State* co = lua_newthread(L);
+    for (int i = narg; i <= narg + nargs; ++i)
+        lua_pushvalue(L, i);
+    lua_xmove(L, co, nargs + 1);
+    int threadRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    CoroutineWait wait;
+    if (!ResumeCoroutine(co, nargs, wait))
+    {
+        luaL_unref(L, LUA_REGISTRYINDEX, threadRef);
+        Push();
+        return;
+    }
+
+    processor->AddCoroutine(threadRef, wait.delay, wait.timeout);
+    Push(threadRef);
+}
+
+bool Eluna::ResumeCoroutine(lua_State* co, int nargs, CoroutineWait& wait)
+{
+    // Methods use L, so it refers to the coroutine while it runs
+    lua_State* parent = L;
+    L = co;
+
+    uint64 startTime = event_level == 0 && sElunaConfig->GetTickBudget() ? ElunaUtil::GetCurrTimeUs() : 0;
+
+    ++event_level;
+    int nres = 0;
+    int status = eluna_resume(co, parent, nargs, &nres);
+    if (--event_level == 0)
+        ++outermostCalls;
+
+    L = parent;
+
+    if (startTime)
+        tickLuaTime += ElunaUtil::GetCurrTimeUs() - startTime;
+
+    if (status != LUA_YIELD)
+    {
+        // The coroutine returned or raised an error, either way it is done
+        if (status)
+            Report(co);
+        return false;
+    }
+
+    // Sleep yields the marker and the delay, WaitUntil the marker, its predicate, timeout and interval
+    // Any other yield waits for the next update
+    wait = CoroutineWait();
+    bool marked = nres >= 2 && lua_touserdata(co, -nres) == &CoroutineWaitMarker;
+    if (marked && nres == 4)
+    {
+        wait.timeout = static_cast<uint32>(lua_tonumber(co, -2));
+        wait.delay = static_cast<uint32>(lua_tonumber(co, -1));
+
+        // Only the predicate is kept, see OnCoroutineEvent
+        lua_pushvalue(co, -3);
+        lua_replace(co, 1);
+        lua_settop(co, 1);
+    }
+    else
+    {
+        if (marked)
+            wait.delay = static_cast<uint32>(lua_tonumber(co, -1));
+        lua_settop(co, 0);
+    }
+    return true;
+}
+
 bool Eluna::ExecuteCall(int params, int res)
 {
     int top = lua_gettop(L);
@@ -332,10 +514,17 @@ bool Eluna::ExecuteCall(int params, int res)
         // Stack: traceback, function, [parameters]
     }
 
+    // Only the outermost call is timed, nested calls are part of it
+    uint64 startTime = event_level == 0 && sElunaConfig->GetTickBudget() ? ElunaUtil::GetCurrTimeUs() : 0;
+
     // Objects are invalidated when event_level hits 0
     ++event_level;
     int result = lua_pcall(L, params, res, usetrace ? base : 0);
-    --event_level;
+    if (--event_level == 0)
+        ++outermostCalls;
+
+    if (startTime)
+        tickLuaTime += ElunaUtil::GetCurrTimeUs() - startTime;
 
     if (usetrace)
     {
@@ -371,11 +560,26 @@ void Eluna::Push()
 }
 void Eluna::Push(const long long l)
 {
+#if defined ELUNA_NATIVE_INT64
+    if (sElunaConfig->IsNativeInt64Enabled())
+    {
+        lua_pushinteger(L, static_cast<lua_Integer>(l));
+        return;
+    }
+#endif
     // pushing pointer to local is fine, a copy of value will be stored, not pointer itself
     ElunaTemplate<long long>::Push(this, &l);
 }
 void Eluna::Push(const unsigned long long l)
 {
+#if defined ELUNA_NATIVE_INT64
+    if (sElunaConfig->IsNativeInt64Enabled())
+    {
+        // values above 2^63 - 1 become negative integers and are converted back unchanged by CHECKVAL
+        lua_pushinteger(L, static_cast<lua_Integer>(l));
+        return;
+    }
+#endif
     // pushing pointer to local is fine, a copy of value will be stored, not pointer itself
     ElunaTemplate<unsigned long long>::Push(this, &l);
 }
@@ -494,9 +698,112 @@ void Eluna::Push(Object const* obj)
 }
 void Eluna::Push(ObjectGuid const guid)
 {
+#if defined ELUNA_NATIVE_INT64
+    if (sElunaConfig->IsNativeInt64Enabled())
+    {
+        Push(guid.GetRawValue());
+        return;
+    }
+#endif
     // pushing pointer to local is fine, a copy of value will be stored, not pointer itself
     ElunaTemplate<ObjectGuid>::Push(this, &guid);
 }
+void Eluna::Push(ElunaPosition const& pos)
+{
+    ElunaTemplate<ElunaPosition>::Push(this, &pos);
+}
+
+bool Eluna::PushInternedObject(const void* ptr, const char* tname)
+{
+    // The cache was filled during an earlier call stack
+    if (objectCacheCall != outermostCalls)
+        return false;
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, objectCacheRef);
+    lua_pushlightuserdata(L, const_cast<void*>(ptr));
+    lua_rawget(L, -2);
+    // Stack: cache, userdata or nil
+
+    // Invalidated userdata of an earlier call stack or a dead object no longer matches the pointer
+    ElunaObject* elunaObj = static_cast<ElunaObject*>(lua_touserdata(L, -1));
+    if (elunaObj && elunaObj->GetTypeName() == tname && elunaObj->GetObjIfValid() == ptr)
+    {
+        lua_remove(L, -2);
+        // Stack: userdata
+        return true;
+    }
+
+    lua_pop(L, 2);
+    return false;
+}
+
+void Eluna::InternObject(const void* ptr)
+{
+    // Stack: userdata
+    lua_rawgeti(L, LUA_REGISTRYINDEX, objectCacheRef);
+    if (objectCacheCall != outermostCalls)
+    {
+        // Replace the userdata of earlier call stacks with a new table that shares the weak metatable
+        lua_newtable(L);
+        lua_getmetatable(L, -2);
+        lua_setmetatable(L, -2);
+        lua_replace(L, -2);
+        lua_pushvalue(L, -1);
+        lua_rawseti(L, LUA_REGISTRYINDEX, objectCacheRef);
+        objectCacheCall = outermostCalls;
+    }
+    lua_pushlightuserdata(L, const_cast<void*>(ptr));
+    lua_pushvalue(L, -3);
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+    // Stack: userdata
+}
+
+void Eluna::PushCachedString(const char* str, size_t len)
+{
+    CachedString& entry = stringCache[(reinterpret_cast<uintptr_t>(str) >> 3) % stringCache.size()];
+    if (entry.text == str)
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, entry.ref);
+
+        // The text at the address may have changed, for example after a template reload
+        size_t cachedLen;
+        const char* cached = lua_tolstring(L, -1, &cachedLen);
+        if (cachedLen == len && memcmp(cached, str, len) == 0)
+            return;
+
+        lua_pop(L, 1);
+    }
+
+    if (entry.text)
+        luaL_unref(L, LUA_REGISTRYINDEX, entry.ref);
+
+    lua_pushlstring(L, str, len);
+    lua_pushvalue(L, -1);
+    entry.ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    entry.text = str;
+}
+
+void Eluna::PushSpellInfo(uint32 spellId)
+{
+    auto itr = spellInfoRefs.find(spellId);
+    if (itr != spellInfoRefs.end())
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, itr->second);
+        return;
+    }
+
+    ElunaSpellInfo info(spellId);
+    if (!info.GetSpellInfo())
+    {
+        Push();
+        return;
+    }
+
+    ElunaTemplate<ElunaSpellInfo>::Push(this, &info);
+    lua_pushvalue(L, -1);
+    spellInfoRefs[spellId] = luaL_ref(L, LUA_REGISTRYINDEX);
+}
 
 static int CheckIntegerRange(lua_State* luastate, int narg, int min, int max)
 {
@@ -581,12 +888,20 @@ template<> std::string Eluna::CHECKVAL<std::string>(int narg)
 }
 template<> long long Eluna::CHECKVAL<long long>(int narg)
 {
+#if defined ELUNA_NATIVE_INT64
+    if (lua_isinteger(L, narg))
+        return static_cast<long long>(lua_tointeger(L, narg));
+#endif
     if (lua_isnumber(L, narg))
         return static_cast<long long>(CHECKVAL<double>(narg));
     return *(Eluna::CHECKOBJ<long long>(narg, true));
 }
 template<> unsigned long long Eluna::CHECKVAL<unsigned long long>(int narg)
 {
+#if defined ELUNA_NATIVE_INT64
+    if (lua_isinteger(L, narg))
+        return static_cast<unsigned long long>(lua_tointeger(L, narg));
+#endif
     if (lua_isnumber(L, narg))
         return static_cast<unsigned long long>(CHECKVAL<uint32>(narg));
     return *(Eluna::CHECKOBJ<unsigned long long>(narg, true));
@@ -601,46 +916,43 @@ template<> unsigned long Eluna::CHECKVAL<unsigned long>(int narg)
 }
 template<> ObjectGuid Eluna::CHECKVAL<ObjectGuid>(int narg)
 {
+#if defined ELUNA_NATIVE_INT64
+    if (lua_isinteger(L, narg))
+        return ObjectGuid(uint64(lua_tointeger(L, narg)));
+#endif
     ObjectGuid* guid = CHECKOBJ<ObjectGuid>(narg, true);
     return guid ? *guid : ObjectGuid();
 }
-
-template<> Object* Eluna::CHECKOBJ<Object>(int narg, bool error)
-{
-    Object* obj = CHECKOBJ<WorldObject>(narg, false);
-    if (!obj)
-        obj = CHECKOBJ<Item>(narg, false);
-    if (!obj)
-        obj = ElunaTemplate<Object>::Check(this, narg, error);
-    return obj;
-}
-template<> WorldObject* Eluna::CHECKOBJ<WorldObject>(int narg, bool error)
+template<> ElunaPosition Eluna::CHECKVAL<ElunaPosition>(int narg)
 {
-    WorldObject* obj = CHECKOBJ<Unit>(narg, false);
-    if (!obj)
-        obj = CHECKOBJ<GameObject>(narg, false);
-    if (!obj)
-        obj = CHECKOBJ<Corpse>(narg, false);
-    if (!obj)
-        obj = ElunaTemplate<WorldObject>::Check(this, narg, error);
-    return obj;
+    ElunaPosition* pos = CHECKOBJ<ElunaPosition>(narg, true);
+    return pos ? *pos : ElunaPosition();
 }
-template<> Unit* Eluna::CHECKOBJ<Unit>(int narg, bool error)
+
+int Eluna::CHECKPOS(int narg, ElunaPosition& pos, bool orientation)
 {
-    Unit* obj = CHECKOBJ<Player>(narg, false);
-    if (!obj)
-        obj = CHECKOBJ<Creature>(narg, false);
-    if (!obj)
-        obj = ElunaTemplate<Unit>::Check(this, narg, error);
-    return obj;
+    if (lua_isuserdata(L, narg))
+    {
+        pos = CHECKVAL<ElunaPosition>(narg);
+        return narg + 1;
+    }
+
+    pos.x = CHECKVAL<float>(narg);
+    pos.y = CHECKVAL<float>(narg + 1);
+    pos.z = CHECKVAL<float>(narg + 2);
+    if (!orientation)
+        return narg + 3;
+
+    pos.o = CHECKVAL<float>(narg + 3);
+    return narg + 4;
 }
 
 template<> ElunaObject* Eluna::CHECKOBJ<ElunaObject>(int narg, bool error)
 {
-    return CHECKTYPE(narg, NULL, error);
+    return CHECKTYPE(narg, NULL, 0, error);
 }
 
-ElunaObject* Eluna::CHECKTYPE(int narg, const char* tname, bool error)
+ElunaObject* Eluna::CHECKTYPE(int narg, const char* tname, uint64 typeMask, bool error)
 {
     if (lua_islightuserdata(L, narg))
     {
@@ -651,7 +963,7 @@ ElunaObject* Eluna::CHECKTYPE(int narg, const char* tname, bool error)
 
     ElunaObject* elunaObject = static_cast<ElunaObject*>(lua_touserdata(L, narg));
 
-    if (!elunaObject || (tname && elunaObject->GetTypeName() != tname))
+    if (!elunaObject || !elunaObject->IsA(typeMask))
     {
         if (error)
         {
@@ -691,71 +1003,89 @@ static void createCancelCallback(Eluna* e, uint64 bindingID, BindingMap<K>* bind
 }
 
 template<typename K>
-int RegisterBasicBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 event_id, int functionRef, uint32 shots)
+int RegisterBasicBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 event_id, int functionRef, uint32 shots, uint8 priority)
 {
     typedef EventKey<K> Key;
     auto binding = e->GetBinding<Key>(regtype);
     auto key = Key(static_cast<K>(event_id));
-    uint64 bindingID = binding->Insert(key, functionRef, shots);
+    uint64 bindingID = binding->Insert(key, functionRef, shots, priority);
     createCancelCallback(e, bindingID, binding);
     return 1; // Stack: callback
 }
 
 template<typename K>
-int RegisterEntryBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 entry, uint32 event_id, int functionRef, uint32 shots)
+int RegisterEntryBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 entry, uint32 event_id, int functionRef, uint32 shots, uint8 priority)
 {
     typedef EntryKey<K> Key;
     auto binding = e->GetBinding<Key>(regtype);
     auto key = Key(static_cast<K>(event_id), entry);
-    uint64 bindingID = binding->Insert(key, functionRef, shots);
+    uint64 bindingID = binding->Insert(key, functionRef, shots, priority);
     createCancelCallback(e, bindingID, binding);
     return 1; // Stack: callback
 }
 
 template<typename K>
-int RegisterUniqueBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes> regtype, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots)
+int RegisterUniqueBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes> regtype, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots, uint8 priority)
 {
     typedef UniqueObjectKey<K> Key;
     auto binding = e->GetBinding<Key>(regtype);
     auto key = Key(static_cast<K>(event_id), guid, instanceId);
-    uint64 bindingID = binding->Insert(key, functionRef, shots);
+    uint64 bindingID = binding->Insert(key, functionRef, shots, priority);
     createCancelCallback(e, bindingID, binding);
     return 1; // Stack: callback
 }
 
 // Saves the function reference ID given to the register type's store for given entry under the given event
-int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots)
+int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots, uint8 priority)
 {
     switch (regtype)
     {
         case Hooks::REGTYPE_SERVER:
             if (event_id < Hooks::SERVER_EVENT_COUNT)
-                return RegisterBasicBinding<Hooks::ServerEvents>(this, regtype, event_id, functionRef, shots);
+                return RegisterBasicBinding<Hooks::ServerEvents>(this, regtype, event_id, functionRef, shots, priority);
             break;
 
         case Hooks::REGTYPE_PLAYER:
             if (event_id < Hooks::PLAYER_EVENT_COUNT)
-                return RegisterBasicBinding<Hooks::PlayerEvents>(this, regtype, event_id, functionRef, shots);
+                return RegisterBasicBinding<Hooks::PlayerEvents>(this, regtype, event_id, functionRef, shots, priority);
+            break;
+
+        case Hooks::REGTYPE_PLAYER_ENTRY:
+            switch (event_id)
+            {
+                // Only events that carry an item, creature, spell, quest, zone or area ID can be bound per entry
+                case Hooks::PLAYER_EVENT_ON_KILL_CREATURE:
+                case Hooks::PLAYER_EVENT_ON_EQUIP:
+                case Hooks::PLAYER_EVENT_ON_LOOT_ITEM:
+                case Hooks::PLAYER_EVENT_ON_QUEST_ABANDON:
+                case Hooks::PLAYER_EVENT_ON_LEARN_SPELL:
+                case Hooks::PLAYER_EVENT_ON_QUEST_STATUS_CHANGED:
+                case Hooks::PLAYER_EVENT_ON_UPDATE_ZONE:
+                case Hooks::PLAYER_EVENT_ON_UPDATE_AREA:
+                case Hooks::PLAYER_EVENT_ON_LEAVE_ZONE:
+                case Hooks::PLAYER_EVENT_ON_LEAVE_AREA:
+                    return RegisterEntryBinding<Hooks::PlayerEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
+            }
             break;
 
         case Hooks::REGTYPE_GUILD:
             if (event_id < Hooks::GUILD_EVENT_COUNT)
-                return RegisterBasicBinding<Hooks::GuildEvents>(this, regtype, event_id, functionRef, shots);
+                return RegisterBasicBinding<Hooks::GuildEvents>(this, regtype, event_id, functionRef, shots, priority);
             break;
 
         case Hooks::REGTYPE_GROUP:
             if (event_id < Hooks::GROUP_EVENT_COUNT)
-                return RegisterBasicBinding<Hooks::GroupEvents>(this, regtype, event_id, functionRef, shots);
+                return RegisterBasicBinding<Hooks::GroupEvents>(this, regtype, event_id, functionRef, shots, priority);
             break;
 
         case Hooks::REGTYPE_VEHICLE:
             if (event_id < Hooks::VEHICLE_EVENT_COUNT)
-                return RegisterBasicBinding<Hooks::VehicleEvents>(this, regtype, event_id, functionRef, shots);
+                return RegisterBasicBinding<Hooks::VehicleEvents>(this, regtype, event_id, functionRef, shots, priority);
             break;
 
         case Hooks::REGTYPE_BG:
             if (event_id < Hooks::BG_EVENT_COUNT)
-                return RegisterBasicBinding<Hooks::BGEvents>(this, regtype, event_id, functionRef, shots);
+                return RegisterBasicBinding<Hooks::BGEvents>(this, regtype, event_id, functionRef, shots, priority);
             break;
 
         case Hooks::REGTYPE_PACKET:
@@ -767,7 +1097,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                     luaL_error(L, "Couldn't find a creature with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
-                return RegisterEntryBinding<Hooks::PacketEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::PacketEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             }
             break;
 
@@ -780,7 +1110,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                     luaL_error(L, "Couldn't find a creature with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
-                return RegisterEntryBinding<Hooks::CreatureEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::CreatureEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             }
             break;
 
@@ -793,7 +1123,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                     luaL_error(L, "guid was 0!");
                     return 0; // Stack: (empty)
                 }
-                return RegisterUniqueBinding<Hooks::CreatureEvents>(this, regtype, guid, instanceId, event_id, functionRef, shots);
+                return RegisterUniqueBinding<Hooks::CreatureEvents>(this, regtype, guid, instanceId, event_id, functionRef, shots, priority);
             }
             break;
 
@@ -806,7 +1136,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                     luaL_error(L, "Couldn't find a creature with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
-                return RegisterEntryBinding<Hooks::GossipEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::GossipEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             }
             break;
 
@@ -819,7 +1149,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                     luaL_error(L, "Couldn't find a gameobject with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
-                return RegisterEntryBinding<Hooks::GameObjectEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::GameObjectEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             }
             break;
 
@@ -832,13 +1162,13 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                     luaL_error(L, "Couldn't find a gameobject with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
-                return RegisterEntryBinding<Hooks::GossipEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::GossipEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             }
             break;
 
         case Hooks::REGTYPE_SPELL:
             if (event_id < Hooks::SPELL_EVENT_COUNT)
-                return RegisterEntryBinding<Hooks::SpellEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::SpellEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             break;
 
         case Hooks::REGTYPE_ITEM:
@@ -850,7 +1180,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                     luaL_error(L, "Couldn't find a item with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
-                return RegisterEntryBinding<Hooks::ItemEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::ItemEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             }
             break;
 
@@ -863,19 +1193,19 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                     luaL_error(L, "Couldn't find a item with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
-                return RegisterEntryBinding<Hooks::GossipEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::GossipEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             }
             break;
 
         case Hooks::REGTYPE_PLAYER_GOSSIP:
             if (event_id < Hooks::GOSSIP_EVENT_COUNT)
-                return RegisterEntryBinding<Hooks::GossipEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::GossipEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             break;
 
         case Hooks::REGTYPE_MAP:
         case Hooks::REGTYPE_INSTANCE:
             if (event_id < Hooks::INSTANCE_EVENT_COUNT)
-                return RegisterEntryBinding<Hooks::InstanceEvents>(this, regtype, entry, event_id, functionRef, shots);
+                return RegisterEntryBinding<Hooks::InstanceEvents>(this, regtype, entry, event_id, functionRef, shots, priority);
             break;
     }
     luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
@@ -893,16 +1223,174 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
 
 void Eluna::UpdateEluna(uint32 diff)
 {
+    // Shed cosmetic bindings during the next tick if this one went over budget
+    if (uint64 budget = sElunaConfig->GetTickBudget())
+    {
+        if (tickLuaTime > budget)
+        {
+            ++overrunTicks;
+            shedPriority = Hooks::BINDING_PRIORITY_COSMETIC;
+        }
+        else
+            shedPriority = Hooks::BINDING_PRIORITY_COUNT;
+    }
+    else
+        shedPriority = Hooks::BINDING_PRIORITY_COUNT;
+
+    lastTickLuaTime = tickLuaTime;
+    tickLuaTime = 0;
+
     if (reload && sElunaLoader->GetCacheState() == SCRIPT_CACHE_READY)
 #if defined ELUNA_TRINITY
-        if (GetQueryProcessor().Empty())
+        if (GetQueryProcessor().Empty() && queryCallbacks.empty())
 #endif
             _ReloadEluna();
 
+    updateStartTime = sElunaConfig->GetTickBudget() ? ElunaUtil::GetCurrTimeUs() : 0;
+    updateCalls = 0;
+    updateBudgetSpent = false;
+
     eventMgr->UpdateProcessors(diff);
 #if defined ELUNA_TRINITY
     GetQueryProcessor().ProcessReadyCallbacks();
 #endif
+#if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
+    RunQueryCallbacks();
+    size_t carriedCallbacks = queryCallbacks.size();
+#else
+    size_t carriedCallbacks = 0;
+#endif
+
+    size_t carriedProcessors = eventMgr->GetCarriedProcessors();
+    if (carriedProcessors || carriedCallbacks)
+        ++carryOverTicks;
+    maxCarriedProcessors = std::max(maxCarriedProcessors, carriedProcessors);
+    maxCarriedCallbacks = std::max(maxCarriedCallbacks, carriedCallbacks);
+}
+
+void Eluna::SpendUpdateBudget()
+{
+    ++updateCalls;
+
+    uint32 callLimit = sElunaConfig->GetUpdateCallLimit();
+    uint32 budget = sElunaConfig->GetTickBudget();
+    if ((callLimit && updateCalls >= callLimit) || (budget && ElunaUtil::GetCurrTimeUs() - updateStartTime >= budget))
+        updateBudgetSpent = true;
+}
+
+#if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
+void Eluna::RunQueryCallbacks()
+{
+    // At least one callback runs each tick, so the callbacks are not held back indefinitely by the timed events
+    bool first = true;
+    while (!queryCallbacks.empty() && (first || HasUpdateBudget()))
+    {
+        QueryCallback callback = std::move(queryCallbacks.front());
+        queryCallbacks.pop_front();
+        first = false;
+
+        ElunaQuery* eq = callback.result ? &callback.result : nullptr;
+
+        // Get the Lua function from the registry
+        lua_rawgeti(L, LUA_REGISTRYINDEX, callback.funcRef);
+
+        // Push the query results as a parameter
+        Push(eq);
+
+        // Call the Lua function
+        ExecuteCall(1, 0);
+
+        // Unreference the Lua function
+        luaL_unref(L, LUA_REGISTRYINDEX, callback.funcRef);
+
+        SpendUpdateBudget();
+    }
+}
+#endif
+
+void Eluna::PushLoadStats()
+{
+    lua_newtable(L);
+
+    Push(lastTickLuaTime);
+    lua_setfield(L, -2, "tickTime");
+    Push(sElunaConfig->GetTickBudget());
+    lua_setfield(L, -2, "budget");
+    Push(overrunTicks);
+    lua_setfield(L, -2, "overrunTicks");
+    Push(shedPriority < Hooks::BINDING_PRIORITY_COUNT);
+    lua_setfield(L, -2, "shedding");
+
+    lua_newtable(L);
+    for (auto const& priority : Hooks::BindingPrioritiesTable)
+    {
+        Push(shedCalls[priority.id]);
+        lua_setfield(L, -2, priority.name);
+    }
+    lua_setfield(L, -2, "shed");
+
+    Push(eventMgr->GetCarriedProcessors());
+    lua_setfield(L, -2, "carriedTimers");
+#if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
+    Push(queryCallbacks.size());
+#else
+    Push(0);
+#endif
+    lua_setfield(L, -2, "carriedCallbacks");
+    Push(maxCarriedProcessors);
+    lua_setfield(L, -2, "maxCarriedTimers");
+    Push(maxCarriedCallbacks);
+    lua_setfield(L, -2, "maxCarriedCallbacks");
+    Push(carryOverTicks);
+    lua_setfield(L, -2, "carryOverTicks");
+}
+
+// Returns the method stats ordered by total time, most first
+template<typename StatsMap>
+static std::vector<typename StatsMap::mapped_type const*> GetSortedMethodStats(StatsMap const& methodStats)
+{
+    typedef typename StatsMap::mapped_type Stats;
+
+    std::vector<Stats const*> sorted;
+    sorted.reserve(methodStats.size());
+    for (auto const& itr : methodStats)
+        sorted.push_back(&itr.second);
+
+    std::sort(sorted.begin(), sorted.end(), [](Stats const* a, Stats const* b) { return a->time > b->time; });
+    return sorted;
+}
+
+void Eluna::PushMethodStats()
+{
+    std::vector<MethodStats const*> sorted = GetSortedMethodStats(methodStats);
+
+    lua_createtable(L, static_cast<int>(sorted.size()), 0);
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        lua_createtable(L, 0, 4);
+        Push(sorted[i]->type);
+        lua_setfield(L, -2, "type");
+        Push(sorted[i]->method);
+        lua_setfield(L, -2, "method");
+        Push(sorted[i]->calls);
+        lua_setfield(L, -2, "calls");
+        Push(sorted[i]->time);
+        lua_setfield(L, -2, "time");
+        lua_rawseti(L, -2, static_cast<int>(i + 1));
+    }
+}
+
+bool Eluna::DumpMethodStats(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+        return false;
+
+    file << "type,method,calls,time_ns,avg_ns\n";
+    for (MethodStats const* stats : GetSortedMethodStats(methodStats))
+        file << stats->type << ',' << stats->method << ',' << stats->calls << ',' << stats->time << ',' << (stats->time / stats->calls) << '\n';
+
+    return static_cast<bool>(file);
 }
 
 /*
@@ -1065,6 +1553,27 @@ void Eluna::FreeInstanceId(uint32 instanceId)
     }
 }
 
+const char* Eluna::RegisterGossipMenu(uint8 typeId, uint32 entry, int index)
+{
+    ElunaGossipMenu menu;
+    if (const char* error = menu.Load(L, index))
+        return error;
+
+    gossipMenus[(uint64(typeId) << 32) | entry] = std::move(menu);
+    return NULL;
+}
+
+void Eluna::ClearGossipMenu(uint8 typeId, uint32 entry)
+{
+    gossipMenus.erase((uint64(typeId) << 32) | entry);
+}
+
+const ElunaGossipMenu* Eluna::GetGossipMenu(uint8 typeId, uint32 entry) const
+{
+    auto itr = gossipMenus.find((uint64(typeId) << 32) | entry);
+    return itr != gossipMenus.end() ? &itr->second : NULL;
+}
+
 void Eluna::PushInstanceData(ElunaInstanceAI* ai, bool incrementCounter)
 {
     // Check if the instance data is missing (i.e. someone reloaded Eluna).
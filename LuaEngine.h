@@ -34,9 +34,13 @@
 #include "Entities/Player.h"
 #endif
 
+#include <array>
+#include <deque>
 #include <mutex>
 #include <memory>
 #include "ElunaSpellWrapper.h"
+#include "ElunaGossipMenu.h"
+#include "ElunaPosition.h"
 
 extern "C"
 {
@@ -72,6 +76,7 @@ class GameObjectAI;
 class InstanceScript;
 class TempSummon;
 class Vehicle;
+struct CreatureTemplate;
 struct ItemTemplate;
 typedef Battleground BattleGround;
 typedef BattlegroundTypeId BattleGroundTypeId;
@@ -81,8 +86,10 @@ typedef AreaTrigger AreaTriggerEntry;
 #endif
 #else
 class InstanceData;
+struct CreatureInfo;
 struct ItemPrototype;
 struct SpellEntry;
+typedef CreatureInfo CreatureTemplate;
 typedef ItemPrototype ItemTemplate;
 typedef SpellEffectIndex SpellEffIndex;
 typedef SpellEntry SpellInfo;
@@ -109,9 +116,12 @@ typedef VehicleInfo Vehicle;
 
 struct lua_State;
 class EventMgr;
+class ElunaEventProcessor;
 class ElunaObject;
+struct LuaEvent;
 class BaseBindingMap;
 template<typename T> class ElunaTemplate;
+template<typename T> class ElunaTemplateView;
 
 template<typename K> class BindingMap;
 template<typename T> struct EventKey;
@@ -164,7 +174,22 @@ public:
     void ReloadEluna() { reload = true; }
     bool ExecuteCall(int params, int res);
 
+    /*
+     * Runs the function at `narg` with the values after it as a coroutine until it waits in Sleep or WaitUntil,
+     *   after which it is resumed by `processor`. Pushes the coroutine ID, or nil if it did not wait.
+     */
+    void StartCoroutine(ElunaEventProcessor* processor, int narg);
+
 private:
+    // What a coroutine waits for when it yields, see Sleep and WaitUntil in LuaEngine.cpp
+    struct CoroutineWait
+    {
+        uint32 delay = 0;
+        uint32 timeout = 0;
+    };
+    // Resumes `co` with `nargs` values on its stack, returns true and what it waits for if it yielded
+    bool ResumeCoroutine(lua_State* co, int nargs, CoroutineWait& wait);
+
 
     // Indicates that the lua state should be reloaded
     bool reload = false;
@@ -184,12 +209,82 @@ private:
     //  this is used to keep track of how many arguments were pushed.
     uint8 push_counter;
 
+    // Lua time spent since the last UpdateEluna call, in microseconds
+    uint64 tickLuaTime;
+    // Lua time spent in the previous tick, in microseconds
+    uint64 lastTickLuaTime;
+    // Bindings of this priority class or lower are skipped by hooks that ignore the results, see Eluna.TickBudget
+    uint8 shedPriority;
+    // Amount of ticks that went over the Lua time budget
+    uint64 overrunTicks;
+    // Amount of handler calls skipped per priority class
+    uint64 shedCalls[Hooks::BINDING_PRIORITY_COUNT];
+
+    // Timed events and query callbacks run by UpdateEluna stop for the tick when the budget is spent, see Eluna.TickBudget
+    uint64 updateStartTime;
+    uint32 updateCalls;
+    bool updateBudgetSpent;
+    // Amount of ticks that left work for the next tick, and the most work left by a tick
+    uint64 carryOverTicks;
+    size_t maxCarriedProcessors;
+    size_t maxCarriedCallbacks;
+
+    // Call counts and time of the bound methods called in this state, see Eluna.MethodProfiling
+    struct MethodStats
+    {
+        const char* type;
+        const char* method;
+        uint64 calls = 0;
+        uint64 time = 0;
+    };
+    // Inherited methods are shared by several types, so they are counted per type name and method registration
+    typedef std::pair<const char*, const void*> MethodStatsKey;
+    struct MethodStatsKeyHash
+    {
+        size_t operator()(MethodStatsKey const& key) const { return std::hash<const void*>()(key.first) ^ (std::hash<const void*>()(key.second) << 1); }
+    };
+    bool methodProfiling;
+    std::unordered_map<MethodStatsKey, MethodStats, MethodStatsKeyHash> methodStats;
+
     Map* const boundMap;
 
+    // Registry ref of the weak table that maps object pointers to their userdata, see PushInternedObject
+    int objectCacheRef;
+    // Amount of outermost calls into Lua that returned, the object cache only holds the userdata pushed for the current one
+    uint64 outermostCalls;
+    uint64 objectCacheCall;
+
+    /*
+     * Direct mapped cache of Lua strings keyed by the address of their C++ text, see PushCachedString.
+     *
+     * Each slot holds a registry ref to one immutable string until the slot is reused
+     *   or the state is closed, so it never holds more than its size in strings.
+     */
+    struct CachedString
+    {
+        const char* text = NULL;
+        int ref = 0;
+    };
+    std::array<CachedString, 256> stringCache;
+
+    // Map from spell ID -> registry ref of its ElunaSpellInfo userdata, see PushSpellInfo
+    std::unordered_map<uint32, int> spellInfoRefs;
+    // Map from template address -> registry ref of its template view userdata, see PushTemplateView
+    std::unordered_map<const void*, int> templateViewRefs;
+
     // Map from instance ID -> Lua table ref
     std::unordered_map<uint32, int> instanceDataRefs;
     // Map from map ID -> Lua table ref
     std::unordered_map<uint32, int> continentDataRefs;
+    struct PlayerZone
+    {
+        uint32 zone = 0;
+        uint32 area = 0;
+    };
+    // Map from player GUID -> last zone and area seen by OnUpdateZone and OnUpdateArea, used for the leave zone and area events
+    std::unordered_map<uint64, PlayerZone> playerZones;
+    // Map from object type and entry -> static gossip menu
+    std::unordered_map<uint64, ElunaGossipMenu> gossipMenus;
 
     std::array<std::unique_ptr<BaseBindingMap>, Hooks::REGTYPE_COUNT> bindingMaps;
 
@@ -213,9 +308,16 @@ private:
     // This is called on world update to reload eluna
     void _ReloadEluna();
 
+    // Fires the leave events for the last zone and area seen for the player and forgets them, used when the player leaves the state
+    void LeavePlayerZone(Player* pPlayer);
+
+    // Render and handle static gossip menus, see RegisterGossipMenu
+    bool SendGossipMenu(Player* pPlayer, WorldObject* pObject, const ElunaGossipMenu& menu, uint32 pageId);
+    bool OnGossipMenuSelect(Player* pPlayer, WorldObject* pObject, const ElunaGossipMenu& menu, uint32 sender, uint32 action);
+
     // Some helpers for hooks to call event handlers.
     // The bodies of the templates are in HookHelpers.h, so if you want to use them you need to #include "HookHelpers.h".
-    template<typename K1, typename K2> int SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments);
+    template<typename K1, typename K2> int SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments, bool sheddable = false);
                                        int CallOneFunction(int number_of_functions, int number_of_arguments, int number_of_results);
                                        void CleanUpStack(int number_of_arguments);
     template<typename T>               void ReplaceArgument(T value, int index);
@@ -272,6 +374,16 @@ private:
 
 #if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
     QueryCallbackProcessor queryProcessor;
+
+    // Results of async queries waiting for their Lua callback to be called, in the order they completed
+    struct QueryCallback
+    {
+        int funcRef;
+        ElunaQuery result;
+    };
+    std::deque<QueryCallback> queryCallbacks;
+
+    void RunQueryCallbacks();
 #endif
 public:
 
@@ -280,6 +392,8 @@ public:
 
 #if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
     QueryCallbackProcessor& GetQueryProcessor() { return queryProcessor; }
+    // Queues the Lua callback of a completed async query, it is called by UpdateEluna within the update budget
+    void QueueQueryCallback(int funcRef, ElunaQuery result) { queryCallbacks.push_back({ funcRef, std::move(result) }); }
 #endif
 
     static int StackTrace(lua_State* _L);
@@ -288,6 +402,12 @@ public:
     // Never returns nullptr
     static Eluna* GetEluna(lua_State* L)
     {
+#if LUA_VERSION_NUM >= 503
+        // Set in OpenLua, coroutines inherit the main thread's extra space
+        Eluna* E = *static_cast<Eluna**>(lua_getextraspace(L));
+        ASSERT(E);
+        return E;
+#else
         lua_pushstring(L, ELUNA_STATE_PTR);
         lua_rawget(L, LUA_REGISTRYINDEX);
         ASSERT(lua_islightuserdata(L, -1));
@@ -295,6 +415,7 @@ public:
         lua_pop(L, 1);
         ASSERT(E);
         return E;
+#endif
     }
 
     // can be used by anything, including methods.
@@ -316,6 +437,48 @@ public:
     void Push(Pet const* pet);
     void Push(TempSummon const* summon);
     void Push(ObjectGuid const guid);
+    void Push(ElunaPosition const& pos);
+
+    /*
+     * Pushes the userdata already created for `ptr` of type `tname` and returns `true`
+     *   if it was created within the current call stack and still refers to that object.
+     *   Otherwise pushes nothing and returns `false`.
+     */
+    bool PushInternedObject(const void* ptr, const char* tname);
+    // Remembers the userdata on top of the stack as the userdata of `ptr`
+    void InternObject(const void* ptr);
+
+    /*
+     * Pushes a string whose text stays at the same address, such as template and map names.
+     *   Object names are stored per object, so caching them would only evict the stable strings and they are pushed with Push.
+     *
+     * The Lua string is cached by the address of the text, so pushing it again
+     *   only compares the text instead of hashing and interning it.
+     */
+    void PushCachedString(const char* str, size_t len);
+    void PushCachedString(const std::string& str) { PushCachedString(str.c_str(), str.size()); }
+    void PushCachedString(const char* str)
+    {
+        if (str)
+            PushCachedString(str, strlen(str));
+        else
+            Push();
+    }
+    /*
+     * Pushes the [SpellInfo] of the spell, or nil if the spell does not exist.
+     *
+     * Spell data does not change while the state is open, so every spell ID
+     *   is pushed as the same userdata instead of allocating a new one each time.
+     */
+    void PushSpellInfo(uint32 spellId);
+
+    /*
+     * Pushes a read-only view of an item or creature template, or nil if `tmpl` is NULL.
+     *
+     * Templates are not changed after loading, so every template is pushed as the same userdata.
+     */
+    template<typename T> void PushTemplateView(T const* tmpl);
+
     template<typename T>
     void Push(T const* ptr)
     {
@@ -351,8 +514,31 @@ public:
 #if !defined TRACKABLE_PTR_NAMESPACE
     uint64 GetCallstackId() const { return callstackid; }
 #endif
-    int Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots);
+    int Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots, uint8 priority = Hooks::BINDING_PRIORITY_NORMAL);
     void UpdateEluna(uint32 diff);
+    // Pushes a table with the Lua time and load shedding statistics of this state
+    void PushLoadStats();
+
+    // Counts a timed event or query callback run by UpdateEluna against the update budget of the tick
+    void SpendUpdateBudget();
+    bool HasUpdateBudget() const { return !updateBudgetSpent; }
+
+    bool IsMethodProfiling() const { return methodProfiling; }
+    void SetMethodProfiling(bool enable) { methodProfiling = enable; }
+    void ResetMethodStats() { methodStats.clear(); }
+    // Adds a call of `method`, which took `time` nanoseconds, to the method stats
+    void RecordMethodCall(const void* method, const char* type, const char* name, uint64 time)
+    {
+        MethodStats& stats = methodStats[MethodStatsKey(type, method)];
+        stats.type = type;
+        stats.method = name;
+        ++stats.calls;
+        stats.time += time;
+    }
+    // Pushes an array of the method stats, the methods that took the most time first
+    void PushMethodStats();
+    // Writes the method stats to a CSV file, returns false if the file can't be written
+    bool DumpMethodStats(const std::string& path) const;
 
     // Checks
     template<typename T> T CHECKVAL(int narg);
@@ -360,16 +546,33 @@ public:
     {
         return lua_isnoneornil(L, narg) ? def : CHECKVAL<T>(narg);
     }
+    /*
+     * Reads a [Position] or the x, y and z numbers, followed by o if `orientation` is true, at `narg` into `pos`.
+     *
+     * Returns the index of the argument after the position.
+     */
+    int CHECKPOS(int narg, ElunaPosition& pos, bool orientation = false);
     template<typename T> T* CHECKOBJ(int narg, bool error = true)
     {
         return ElunaTemplate<T>::Check(this, narg, error);
     }
-    ElunaObject* CHECKTYPE(int narg, const char* tname, bool error = true);
+    // Checks that the userdata at `narg` is or derives from the type with the ancestor mask `typeMask`, 0 accepts any type
+    ElunaObject* CHECKTYPE(int narg, const char* tname, uint64 typeMask, bool error = true);
 
     CreatureAI* GetAI(Creature* creature);
     InstanceData* GetInstanceData(Map* map);
     void FreeInstanceId(uint32 instanceId);
 
+    /*
+     * Registers the static gossip menu table at `index` for the creature or gameobject `entry`,
+     *   replacing any previous menu.
+     *
+     * Returns an error message if the table is not a valid menu, otherwise NULL.
+     */
+    const char* RegisterGossipMenu(uint8 typeId, uint32 entry, int index);
+    void ClearGossipMenu(uint8 typeId, uint32 entry);
+    const ElunaGossipMenu* GetGossipMenu(uint8 typeId, uint32 entry) const;
+
     Map* GetBoundMap() const { return boundMap; }
 
     int32 GetBoundMapId() const
@@ -416,6 +619,8 @@ public:
 
     /* Custom */
     void OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* obj);
+    // Resumes the coroutine of the event at processor time `now`, returns true if it waits again
+    bool OnCoroutineEvent(LuaEvent* luaEvent, uint64 now);
     bool OnCommand(Player* player, const char* text);
     void OnWorldUpdate(uint32 diff);
     void OnLootItem(Player* pPlayer, Item* pItem, uint32 count, ObjectGuid guid);
@@ -549,6 +754,8 @@ public:
     void OnBindToInstance(Player* pPlayer, Difficulty difficulty, uint32 mapid, bool permanent);
     void OnUpdateZone(Player* pPlayer, uint32 newZone, uint32 newArea);
     void OnUpdateArea(Player* pPlayer, uint32 oldArea, uint32 newArea);
+    void OnLeaveZone(Player* pPlayer, uint32 oldZone, uint32 newZone);
+    void OnLeaveArea(Player* pPlayer, uint32 oldArea, uint32 newArea);
     void OnMapChanged(Player* pPlayer);
     void HandleGossipSelectOption(Player* pPlayer, uint32 menuId, uint32 sender, uint32 action, const std::string& code);
     void OnAchievementComplete(Player* pPlayer, uint32 achievementId);
@@ -663,9 +870,6 @@ public:
     void OnAfterSpellHit(Spell* pSpell);
     void OnEffectCalcAbsorb(Spell* pSpell, DamageInfo const& damageInfo, uint32& resistAmount, int32& absorbAmount);
 };
-template<> Unit* Eluna::CHECKOBJ<Unit>(int narg, bool error);
-template<> Object* Eluna::CHECKOBJ<Object>(int narg, bool error);
-template<> WorldObject* Eluna::CHECKOBJ<WorldObject>(int narg, bool error);
 template<> ElunaObject* Eluna::CHECKOBJ<ElunaObject>(int narg, bool error);
 
 #endif
@@ -292,6 +292,8 @@ class ClassParser(object):
 
     comment_end_regex = re.compile(r"\s*\*/")
     end_regex = re.compile(r"\s*int\s(\w+)\s*\(")
+    # Functions registered with ElunaTypedMethod return the value itself, e.g. `uint32 GetEntry(Object* obj)`
+    typed_end_regex = re.compile(r"\s*(?:const\s+)?\w+\s*\*?\s+(\w+)\s*\(")
 
     @params(self=object, class_name=str, exported_hooks=Nullable(object))
     def __init__(self, class_name: str, exported_hooks: Optional[Dict[str, Dict[str, Dict]]] = None):
@@ -449,6 +451,7 @@ class ClassParser(object):
         proto_regex: handle_proto,
         comment_end_regex: None,
         end_regex: handle_end,
+        typed_end_regex: handle_end,
     }
 
     next_regexes = {
@@ -465,8 +468,9 @@ class ClassParser(object):
         warning_regex: [hook_regex, table_values_regex, table_regex, warning_regex, param_regex, return_regex, comment_end_regex, body_regex],
         param_regex: [hook_regex, table_regex, warning_regex, param_regex, return_regex, comment_end_regex, body_regex],
         return_regex: [hook_regex, return_regex, comment_end_regex],
-        comment_end_regex: [end_regex],
+        comment_end_regex: [end_regex, typed_end_regex],
         end_regex: [],
+        typed_end_regex: [],
         hook_regex: [hook_regex, table_regex, warning_regex, param_regex, return_regex, proto_regex, comment_end_regex, body_regex],
     }
 
@@ -25,8 +25,102 @@ using namespace Hooks;
     if (!binding->HasBindingsFor(key))\
         return RETVAL;
 
+#if defined ELUNA_CMANGOS && ELUNA_EXPANSION < EXP_CATA
+#define PLAYER_MENU(PLAYER) (PLAYER)->GetPlayerMenu()
+#else
+#define PLAYER_MENU(PLAYER) (PLAYER)->PlayerTalkClass
+#endif
+
+static bool IsGossipItemVisible(Player* pPlayer, const ElunaGossipItem& item)
+{
+#if defined ELUNA_MANGOS
+    if (item.minLevel && pPlayer->getLevel() < item.minLevel)
+#else
+    if (item.minLevel && pPlayer->GetLevel() < item.minLevel)
+#endif
+        return false;
+#if defined ELUNA_TRINITY || defined ELUNA_VMANGOS
+    if (item.classId && pPlayer->GetClass() != item.classId)
+#else
+    if (item.classId && pPlayer->getClass() != item.classId)
+#endif
+        return false;
+    if (item.money && pPlayer->GetMoney() < item.money)
+        return false;
+    if (item.questId && pPlayer->GetQuestStatus(item.questId) != item.questStatus)
+        return false;
+    return true;
+}
+
+bool Eluna::SendGossipMenu(Player* pPlayer, WorldObject* pObject, const ElunaGossipMenu& menu, uint32 pageId)
+{
+    const ElunaGossipPage* page = menu.GetPage(pageId);
+    if (!page)
+        return false;
+
+    PLAYER_MENU(pPlayer)->ClearMenus();
+    for (uint32 i = 0; i < page->items.size(); ++i)
+    {
+        const ElunaGossipItem& item = page->items[i];
+        if (!IsGossipItemVisible(pPlayer, item))
+            continue;
+
+        // The page and 1-based option index come back as sender and action on select
+#if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
+        PLAYER_MENU(pPlayer)->GetGossipMenu().AddMenuItem(-1, GossipOptionIcon(item.icon), item.text, pageId, i + 1, "", 0, false);
+#elif ELUNA_EXPANSION == EXP_CLASSIC
+        PLAYER_MENU(pPlayer)->GetGossipMenu().AddMenuItem(item.icon, item.text, pageId, i + 1, "", false);
+#else
+        PLAYER_MENU(pPlayer)->GetGossipMenu().AddMenuItem(item.icon, item.text, pageId, i + 1, "", 0, false);
+#endif
+    }
+
+    PLAYER_MENU(pPlayer)->SendGossipMenu(page->npcText, pObject->GET_GUID());
+    return true;
+}
+
+bool Eluna::OnGossipMenuSelect(Player* pPlayer, WorldObject* pObject, const ElunaGossipMenu& menu, uint32 sender, uint32 action)
+{
+    const ElunaGossipItem* item = menu.GetItem(sender, action);
+    if (!item || !IsGossipItemVisible(pPlayer, *item))
+        return false;
+
+    if (item->submenu)
+        return SendGossipMenu(pPlayer, pObject, menu, item->submenu);
+
+    PLAYER_MENU(pPlayer)->ClearMenus();
+#if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
+    PLAYER_MENU(pPlayer)->SendCloseGossip();
+#else
+    PLAYER_MENU(pPlayer)->CloseGossip();
+#endif
+
+    if (item->callbackRef)
+    {
+        // The callback may replace or clear the menu, so nothing of it is used after the call
+        lua_rawgeti(L, LUA_REGISTRYINDEX, item->callbackRef);
+        Push(pPlayer);
+        Push(pObject);
+        Push(sender);
+        Push(action);
+        ExecuteCall(4, 0);
+
+#if !defined TRACKABLE_PTR_NAMESPACE
+        if (event_level == 0)
+            InvalidateObjects();
+#endif
+    }
+    else if (item->teleport)
+        pPlayer->TeleportTo(item->mapId, item->x, item->y, item->z, item->o);
+
+    return true;
+}
+
 bool Eluna::OnGossipHello(Player* pPlayer, GameObject* pGameObject)
 {
+    if (const ElunaGossipMenu* menu = GetGossipMenu(TYPEID_GAMEOBJECT, pGameObject->GetEntry()))
+        return SendGossipMenu(pPlayer, pGameObject, *menu, ELUNA_GOSSIP_ROOT_PAGE);
+
     START_HOOK_WITH_RETVAL(REGTYPE_GAMEOBJECT_GOSSIP, GOSSIP_EVENT_ON_HELLO, pGameObject->GetEntry(), false);
 #if defined ELUNA_CMANGOS && ELUNA_EXPANSION < EXP_CATA
     pPlayer->GetPlayerMenu()->ClearMenus();
@@ -40,6 +134,9 @@ bool Eluna::OnGossipHello(Player* pPlayer, GameObject* pGameObject)
 
 bool Eluna::OnGossipSelect(Player* pPlayer, GameObject* pGameObject, uint32 sender, uint32 action)
 {
+    if (const ElunaGossipMenu* menu = GetGossipMenu(TYPEID_GAMEOBJECT, pGameObject->GetEntry()))
+        return OnGossipMenuSelect(pPlayer, pGameObject, *menu, sender, action);
+
     START_HOOK_WITH_RETVAL(REGTYPE_GAMEOBJECT_GOSSIP, GOSSIP_EVENT_ON_SELECT, pGameObject->GetEntry(), false);
 #if defined ELUNA_CMANGOS && ELUNA_EXPANSION < EXP_CATA
     pPlayer->GetPlayerMenu()->ClearMenus();
@@ -126,6 +223,9 @@ void Eluna::HandleGossipSelectOption(Player* pPlayer, Item* pItem, uint32 sender
 
 bool Eluna::OnGossipHello(Player* pPlayer, Creature* pCreature)
 {
+    if (const ElunaGossipMenu* menu = GetGossipMenu(TYPEID_UNIT, pCreature->GetEntry()))
+        return SendGossipMenu(pPlayer, pCreature, *menu, ELUNA_GOSSIP_ROOT_PAGE);
+
     START_HOOK_WITH_RETVAL(REGTYPE_CREATURE_GOSSIP, GOSSIP_EVENT_ON_HELLO, pCreature->GetEntry(), false);
 #if defined ELUNA_CMANGOS && ELUNA_EXPANSION < EXP_CATA
     pPlayer->GetPlayerMenu()->ClearMenus();
@@ -139,6 +239,9 @@ bool Eluna::OnGossipHello(Player* pPlayer, Creature* pCreature)
 
 bool Eluna::OnGossipSelect(Player* pPlayer, Creature* pCreature, uint32 sender, uint32 action)
 {
+    if (const ElunaGossipMenu* menu = GetGossipMenu(TYPEID_UNIT, pCreature->GetEntry()))
+        return OnGossipMenuSelect(pPlayer, pCreature, *menu, sender, action);
+
     START_HOOK_WITH_RETVAL(REGTYPE_CREATURE_GOSSIP, GOSSIP_EVENT_ON_SELECT, pCreature->GetEntry(), false);
 #if defined ELUNA_CMANGOS && ELUNA_EXPANSION < EXP_CATA
     auto original_menu = *pPlayer->GetPlayerMenu();
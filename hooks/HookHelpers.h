@@ -63,9 +63,12 @@ struct LuaRet<std::string>
  * Sets up the stack so that event handlers can be called.
  *
  * Returns the number of functions that were pushed onto the stack.
+ *
+ * Only hooks that ignore the results are `sheddable`, a handler of any other hook
+ *   can change what the core does, so it always runs.
  */
 template<typename K1, typename K2>
-int Eluna::SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments)
+int Eluna::SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments, bool sheddable/* = false*/)
 {
     ASSERT(number_of_arguments == this->push_counter);
     ASSERT(key1.event_id == key2.event_id);
@@ -83,9 +86,10 @@ int Eluna::SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, cons
     lua_insert(L, first_argument_index);
     // Stack: event_id, [arguments]
 
-    bindings1->PushRefsFor(key1);
+    uint8 skipPriority = sheddable ? shedPriority : uint8(Hooks::BINDING_PRIORITY_COUNT);
+    bindings1->PushRefsFor(key1, skipPriority, shedCalls);
     if (bindings2)
-        bindings2->PushRefsFor(key2);
+        bindings2->PushRefsFor(key2, skipPriority, shedCalls);
     // Stack: event_id, [arguments], [functions]
 
     int number_of_functions = lua_gettop(L) - arguments_top;
@@ -138,7 +142,7 @@ void Eluna::CallAllFunctions(BindingMap<K1>* bindings1, BindingMap<K2>* bindings
     int number_of_arguments = this->push_counter;
     // Stack: [arguments]
 
-    int number_of_functions = SetupStack(bindings1, bindings2, key1, key2, number_of_arguments);
+    int number_of_functions = SetupStack(bindings1, bindings2, key1, key2, number_of_arguments, true);
     // Stack: event_id, [arguments], [functions]
 
     while (number_of_functions > 0)
@@ -50,6 +50,7 @@ namespace Hooks
         REGTYPE_BG,
         REGTYPE_MAP,
         REGTYPE_INSTANCE,
+        REGTYPE_PLAYER_ENTRY,
         REGTYPE_COUNT
     };
 
@@ -186,7 +187,9 @@ namespace Hooks
         X(PLAYER_EVENT_ON_UPDATE_AREA,             47, "on_update_area")           \
         X(PLAYER_EVENT_ON_TRADE_INIT,              48, "on_trade_init")            \
         X(PLAYER_EVENT_ON_SEND_MAIL,               49, "on_send_mail")             \
-        /* 50–53 unused */ \
+        X(PLAYER_EVENT_ON_LEAVE_ZONE,              50, "on_leave_zone")            \
+        X(PLAYER_EVENT_ON_LEAVE_AREA,              51, "on_leave_area")            \
+        /* 52–53 unused */ \
         X(PLAYER_EVENT_ON_QUEST_STATUS_CHANGED,    54, "on_quest_status_changed")
 
     enum PlayerEvents
@@ -489,6 +492,27 @@ namespace Hooks
     #undef X
     };
 
+    // BINDING PRIORITIES
+    // Under tick overrun cosmetic bindings of hooks that ignore the results are skipped, the others always run
+    #define BINDING_PRIORITIES_LIST(X) \
+        X(BINDING_PRIORITY_CRITICAL,               0,  "critical")                 \
+        X(BINDING_PRIORITY_NORMAL,                 1,  "normal")                   \
+        X(BINDING_PRIORITY_COSMETIC,               2,  "cosmetic")
+
+    enum BindingPriorities
+    {
+    #define X(ID, VALUE, NAME) ID = VALUE,
+        BINDING_PRIORITIES_LIST(X)
+    #undef X
+        BINDING_PRIORITY_COUNT
+    };
+
+    static constexpr EventEntry BindingPrioritiesTable[] = {
+    #define X(ID, VALUE, NAME) { Hooks::ID, NAME },
+        BINDING_PRIORITIES_LIST(X)
+    #undef X
+    };
+
     // Per-category global event table
     static constexpr HookStorage HookTypeTable[] =
     {
@@ -508,6 +532,9 @@ namespace Hooks
         { "instance", InstanceEventsTable, CountOf(InstanceEventsTable) },
     };
 
+    // Binding priorities are not events, they get a global table of their own
+    static constexpr HookStorage BindingPriorityStorage = { "eventPriority", BindingPrioritiesTable, CountOf(BindingPrioritiesTable) };
+
     static constexpr std::pair<const HookStorage*, size_t> getHooks()
     {
         return { HookTypeTable, CountOf(HookTypeTable) };
@@ -28,6 +28,15 @@ using namespace Hooks;
     if (!binding->HasBindingsFor(key))\
         return RETVAL;
 
+#define START_ENTRY_HOOK(EVENT, ENTRY) \
+    auto binding = GetBinding<EventKey<PlayerEvents>>(REGTYPE_PLAYER);\
+    auto entryBinding = GetBinding<EntryKey<PlayerEvents>>(REGTYPE_PLAYER_ENTRY);\
+    auto key = EventKey<PlayerEvents>(EVENT);\
+    auto entryKey = EntryKey<PlayerEvents>(EVENT, ENTRY);\
+    if (!binding->HasBindingsFor(key))\
+        if (!entryBinding->HasBindingsFor(entryKey))\
+            return;
+
 void Eluna::OnLearnTalents(Player* pPlayer, uint32 talentId, uint32 talentRank, uint32 spellid)
 {
     START_HOOK(PLAYER_EVENT_ON_LEARN_TALENTS);
@@ -66,10 +75,10 @@ void Eluna::OnSkillChange(Player* pPlayer, uint32 skillId, uint32 skillValue)
 
 void Eluna::OnLearnSpell(Player* pPlayer, uint32 spellId)
 {
-    START_HOOK(PLAYER_EVENT_ON_LEARN_SPELL);
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_LEARN_SPELL, spellId);
     HookPush(pPlayer);
     HookPush(spellId);
-    CallAllFunctions(binding, key);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
 }
 
 bool Eluna::OnCommand(Player* player, const char* text)
@@ -101,12 +110,12 @@ bool Eluna::OnCommand(Player* player, const char* text)
 
 void Eluna::OnLootItem(Player* pPlayer, Item* pItem, uint32 count, ObjectGuid guid)
 {
-    START_HOOK(PLAYER_EVENT_ON_LOOT_ITEM);
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_LOOT_ITEM, pItem->GetEntry());
     HookPush(pPlayer);
     HookPush(pItem);
     HookPush(count);
     HookPush(guid);
-    CallAllFunctions(binding, key);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
 }
 
 void Eluna::OnLootMoney(Player* pPlayer, uint32 amount)
@@ -140,29 +149,29 @@ void Eluna::OnResurrect(Player* pPlayer)
 
 void Eluna::OnQuestAbandon(Player* pPlayer, uint32 questId)
 {
-    START_HOOK(PLAYER_EVENT_ON_QUEST_ABANDON);
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_QUEST_ABANDON, questId);
     HookPush(pPlayer);
     HookPush(questId);
-    CallAllFunctions(binding, key);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
 }
 
 void Eluna::OnQuestStatusChanged(Player* pPlayer, uint32 questId, uint8 status)
 {
-    START_HOOK(PLAYER_EVENT_ON_QUEST_STATUS_CHANGED);
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_QUEST_STATUS_CHANGED, questId);
     HookPush(pPlayer);
     HookPush(questId);
     HookPush(status);
-    CallAllFunctions(binding, key);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
 }
 
 void Eluna::OnEquip(Player* pPlayer, Item* pItem, uint8 bag, uint8 slot)
 {
-    START_HOOK(PLAYER_EVENT_ON_EQUIP);
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_EQUIP, pItem->GetEntry());
     HookPush(pPlayer);
     HookPush(pItem);
     HookPush(bag);
     HookPush(slot);
-    CallAllFunctions(binding, key);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
 }
 
 InventoryResult Eluna::OnCanUseItem(const Player* pPlayer, uint32 itemEntry)
@@ -211,10 +220,10 @@ void Eluna::OnPVPKill(Player* pKiller, Player* pKilled)
 
 void Eluna::OnCreatureKill(Player* pKiller, Creature* pKilled)
 {
-    START_HOOK(PLAYER_EVENT_ON_KILL_CREATURE);
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_KILL_CREATURE, pKilled->GetEntry());
     HookPush(pKiller);
     HookPush(pKilled);
-    CallAllFunctions(binding, key);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
 }
 
 void Eluna::OnPlayerKilledByCreature(Creature* pKiller, Player* pKilled)
@@ -423,6 +432,8 @@ void Eluna::OnLogin(Player* pPlayer)
 
 void Eluna::OnLogout(Player* pPlayer)
 {
+    LeavePlayerZone(pPlayer);
+
     START_HOOK(PLAYER_EVENT_ON_LOGOUT);
     HookPush(pPlayer);
     CallAllFunctions(binding, key);
@@ -461,20 +472,68 @@ void Eluna::OnBindToInstance(Player* pPlayer, Difficulty difficulty, uint32 mapi
 
 void Eluna::OnUpdateZone(Player* pPlayer, uint32 newZone, uint32 newArea)
 {
-    START_HOOK(PLAYER_EVENT_ON_UPDATE_ZONE);
+    // The core only reports the new zone, so the previous one is tracked per state
+    PlayerZone& last = playerZones[pPlayer->GET_GUID().GetRawValue()];
+    uint32 oldZone = last.zone;
+    last.zone = newZone;
+    last.area = newArea;
+
+    if (oldZone && oldZone != newZone)
+        OnLeaveZone(pPlayer, oldZone, newZone);
+
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_UPDATE_ZONE, newZone);
     HookPush(pPlayer);
     HookPush(newZone);
     HookPush(newArea);
-    CallAllFunctions(binding, key);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
+}
+
+void Eluna::OnLeaveZone(Player* pPlayer, uint32 oldZone, uint32 newZone)
+{
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_LEAVE_ZONE, oldZone);
+    HookPush(pPlayer);
+    HookPush(oldZone);
+    HookPush(newZone);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
 }
 
 void Eluna::OnUpdateArea(Player* pPlayer, uint32 oldArea, uint32 newArea)
 {
-    START_HOOK(PLAYER_EVENT_ON_UPDATE_AREA);
+    playerZones[pPlayer->GET_GUID().GetRawValue()].area = newArea;
+
+    if (oldArea && oldArea != newArea)
+        OnLeaveArea(pPlayer, oldArea, newArea);
+
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_UPDATE_AREA, newArea);
     HookPush(pPlayer);
     HookPush(oldArea);
     HookPush(newArea);
-    CallAllFunctions(binding, key);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
+}
+
+void Eluna::OnLeaveArea(Player* pPlayer, uint32 oldArea, uint32 newArea)
+{
+    START_ENTRY_HOOK(PLAYER_EVENT_ON_LEAVE_AREA, oldArea);
+    HookPush(pPlayer);
+    HookPush(oldArea);
+    HookPush(newArea);
+    CallAllFunctions(binding, entryBinding, key, entryKey);
+}
+
+void Eluna::LeavePlayerZone(Player* pPlayer)
+{
+    auto itr = playerZones.find(pPlayer->GET_GUID().GetRawValue());
+    if (itr == playerZones.end())
+        return;
+
+    // Forgotten before the handlers run, so an update from a handler starts over
+    PlayerZone last = itr->second;
+    playerZones.erase(itr);
+
+    if (last.area)
+        OnLeaveArea(pPlayer, last.area, 0);
+    if (last.zone)
+        OnLeaveZone(pPlayer, last.zone, 0);
 }
 
 void Eluna::OnMapChanged(Player* player)
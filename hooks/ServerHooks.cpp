@@ -82,6 +82,54 @@ void Eluna::OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* o
 #endif
 }
 
+bool Eluna::OnCoroutineEvent(LuaEvent* luaEvent, uint64 now)
+{
+    ASSERT(!event_level);
+
+    // The coroutine is kept alive by the ref of the event
+    lua_rawgeti(L, LUA_REGISTRYINDEX, luaEvent->funcRef);
+    lua_State* co = lua_tothread(L, -1);
+    lua_pop(L, 1);
+
+    // WaitUntil leaves its predicate on the stack of the coroutine, it is checked without resuming the coroutine
+    int nargs = 0;
+    if (lua_gettop(co) == 1)
+    {
+        lua_pushvalue(co, 1);
+        lua_xmove(co, L, 1);
+        bool called = ExecuteCall(0, 1);
+        bool done = lua_toboolean(L, -1) != 0;
+        lua_pop(L, 1);
+
+        // A predicate that raised an error ends the wait like a timeout
+        if (called && !done && (!luaEvent->deadline || now < luaEvent->deadline))
+        {
+#if !defined TRACKABLE_PTR_NAMESPACE
+            InvalidateObjects();
+#endif
+            return true;
+        }
+
+        lua_settop(co, 0);
+        lua_pushboolean(co, done);
+        nargs = 1;
+    }
+
+    CoroutineWait wait;
+    bool waits = ResumeCoroutine(co, nargs, wait);
+    if (waits)
+    {
+        luaEvent->min = luaEvent->max = wait.delay;
+        luaEvent->deadline = wait.timeout ? now + wait.timeout : 0;
+    }
+
+    ASSERT(!event_level);
+#if !defined TRACKABLE_PTR_NAMESPACE
+    InvalidateObjects();
+#endif
+    return waits;
+}
+
 void Eluna::OnGameEventStart(uint32 eventid)
 {
     START_HOOK(GAME_EVENT_START);
@@ -332,6 +380,8 @@ void Eluna::OnPlayerEnter(Map* map, Player* player)
 
 void Eluna::OnPlayerLeave(Map* map, Player* player)
 {
+    LeavePlayerZone(player);
+
     START_HOOK(MAP_EVENT_ON_PLAYER_LEAVE);
     HookPush(map);
     HookPush(player);
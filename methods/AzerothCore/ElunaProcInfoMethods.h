@@ -93,8 +93,7 @@ namespace LuaElunaProcInfo
             return 1;
         }
 
-        ElunaSpellInfo info(procInfo->GetSpellInfo()->Id);
-        E->Push(&info);
+        E->PushSpellInfo(procInfo->GetSpellInfo()->Id);
         return 1;
     }
 
@@ -91,7 +91,7 @@ namespace LuaMap
      */
     int GetName(Eluna* E, Map* map)
     {
-        E->Push(map->GetMapName());
+        E->PushCachedString(map->GetMapName());
         return 1;
     }
 
@@ -31,13 +31,9 @@ namespace LuaObject
      * @param uint32 flag : the flag to check for in the flags data
      * @return bool hasFlag
      */
-    int HasFlag(Eluna* E, Object* obj)
+    bool HasFlag(Object* obj, uint16 index, uint32 flag)
     {
-        uint16 index = E->CHECKVAL<uint16>(2);
-        uint32 flag = E->CHECKVAL<uint32>(3);
-
-        E->Push(obj->HasFlag(index, flag));
-        return 1;
+        return obj->HasFlag(index, flag);
     }
 
     /**
@@ -45,10 +41,9 @@ namespace LuaObject
      *
      * @return bool inWorld
      */
-    int IsInWorld(Eluna* E, Object* obj)
+    bool IsInWorld(Object* obj)
     {
-        E->Push(obj->IsInWorld());
-        return 1;
+        return obj->IsInWorld();
     }
 
     /**
@@ -57,11 +52,9 @@ namespace LuaObject
      * @param uint16 index
      * @return int32 value
      */
-    int GetInt32Value(Eluna* E, Object* obj)
+    int32 GetInt32Value(Object* obj, uint16 index)
     {
-        uint16 index = E->CHECKVAL<uint16>(2);
-        E->Push(obj->GetInt32Value(index));
-        return 1;
+        return obj->GetInt32Value(index);
     }
 
     /**
@@ -70,11 +63,9 @@ namespace LuaObject
      * @param uint16 index
      * @return uint32 value
      */
-    int GetUInt32Value(Eluna* E, Object* obj)
+    uint32 GetUInt32Value(Object* obj, uint16 index)
     {
-        uint16 index = E->CHECKVAL<uint16>(2);
-        E->Push(obj->GetUInt32Value(index));
-        return 1;
+        return obj->GetUInt32Value(index);
     }
 
     /**
@@ -83,11 +74,9 @@ namespace LuaObject
      * @param uint16 index
      * @return float value
      */
-    int GetFloatValue(Eluna* E, Object* obj)
+    float GetFloatValue(Object* obj, uint16 index)
     {
-        uint16 index = E->CHECKVAL<uint16>(2);
-        E->Push(obj->GetFloatValue(index));
-        return 1;
+        return obj->GetFloatValue(index);
     }
 
     /**
@@ -99,12 +88,9 @@ namespace LuaObject
      * @param uint8 offset : should be 0, 1, 2, or 3
      * @return uint8 value
      */
-    int GetByteValue(Eluna* E, Object* obj)
+    uint8 GetByteValue(Object* obj, uint16 index, uint8 offset)
     {
-        uint16 index = E->CHECKVAL<uint16>(2);
-        uint8 offset = E->CHECKVAL<uint8>(3);
-        E->Push(obj->GetByteValue(index, offset));
-        return 1;
+        return obj->GetByteValue(index, offset);
     }
 
     /**
@@ -116,12 +102,9 @@ namespace LuaObject
      * @param uint8 offset : should be 0 or 1
      * @return uint16 value
      */
-    int GetUInt16Value(Eluna* E, Object* obj)
+    uint16 GetUInt16Value(Object* obj, uint16 index, uint8 offset)
     {
-        uint16 index = E->CHECKVAL<uint16>(2);
-        uint8 offset = E->CHECKVAL<uint8>(3);
-        E->Push(obj->GetUInt16Value(index, offset));
-        return 1;
+        return obj->GetUInt16Value(index, offset);
     }
 
     /**
@@ -131,10 +114,9 @@ namespace LuaObject
      *
      * @return float scale
      */
-    int GetScale(Eluna* E, Object* obj)
+    float GetScale(Object* obj)
     {
-        E->Push(obj->GetObjectScale());
-        return 1;
+        return obj->GetObjectScale();
     }
 
     /**
@@ -144,10 +126,9 @@ namespace LuaObject
      *
      * @return uint32 entry
      */
-    int GetEntry(Eluna* E, Object* obj)
+    uint32 GetEntry(Object* obj)
     {
-        E->Push(obj->GetEntry());
-        return 1;
+        return obj->GetEntry();
     }
 
     /**
@@ -455,16 +436,16 @@ namespace LuaObject
     ElunaRegister<Object> ObjectMethods[] =
     {
         // Getters
-        { "GetEntry", &LuaObject::GetEntry },
+        { "GetEntry", &ElunaTypedMethod<&LuaObject::GetEntry> },
         { "GetGUID", &LuaObject::GetGUID },
         { "GetGUIDLow", &LuaObject::GetGUIDLow },
-        { "GetInt32Value", &LuaObject::GetInt32Value },
-        { "GetUInt32Value", &LuaObject::GetUInt32Value },
-        { "GetFloatValue", &LuaObject::GetFloatValue },
-        { "GetByteValue", &LuaObject::GetByteValue },
-        { "GetUInt16Value", &LuaObject::GetUInt16Value },
+        { "GetInt32Value", &ElunaTypedMethod<&LuaObject::GetInt32Value> },
+        { "GetUInt32Value", &ElunaTypedMethod<&LuaObject::GetUInt32Value> },
+        { "GetFloatValue", &ElunaTypedMethod<&LuaObject::GetFloatValue> },
+        { "GetByteValue", &ElunaTypedMethod<&LuaObject::GetByteValue> },
+        { "GetUInt16Value", &ElunaTypedMethod<&LuaObject::GetUInt16Value> },
         { "GetUInt64Value", &LuaObject::GetUInt64Value },
-        { "GetScale", &LuaObject::GetScale },
+        { "GetScale", &ElunaTypedMethod<&LuaObject::GetScale> },
         { "GetTypeId", &LuaObject::GetTypeId },
 
         // Setters
@@ -480,8 +461,8 @@ namespace LuaObject
         { "SetFlag", &LuaObject::SetFlag },
 
         // Boolean
-        { "IsInWorld", &LuaObject::IsInWorld },
-        { "HasFlag", &LuaObject::HasFlag },
+        { "IsInWorld", &ElunaTypedMethod<&LuaObject::IsInWorld> },
+        { "HasFlag", &ElunaTypedMethod<&LuaObject::HasFlag> },
 
         // Other
         { "ToGameObject", &LuaObject::ToGameObject },
@@ -167,6 +167,17 @@ namespace LuaWorldObject
         return 4;
     }
 
+    /**
+     * Returns the coordinates and orientation of the [WorldObject] as a [Position]
+     *
+     * @return [Position] pos
+     */
+    int GetPosition(Eluna* E, WorldObject* obj)
+    {
+        E->Push(ElunaPosition(obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ(), obj->GetOrientation()));
+        return 1;
+    }
+
     /**
      * Returns the nearest [Player] object in sight of the [WorldObject] or within the given range
      *
@@ -426,11 +437,13 @@ namespace LuaWorldObject
      *
      * @proto dist = (obj)
      * @proto dist = (x, y, z)
+     * @proto dist = (pos)
      *
      * @param [WorldObject] obj
      * @param float x : the X-coordinate of the point
      * @param float y : the Y-coordinate of the point
      * @param float z : the Z-coordinate of the point
+     * @param [Position] pos : the point
      *
      * @return float dist : the distance in yards
      */
@@ -441,10 +454,9 @@ namespace LuaWorldObject
             E->Push(obj->GetDistance(target));
         else
         {
-            float X = E->CHECKVAL<float>(2);
-            float Y = E->CHECKVAL<float>(3);
-            float Z = E->CHECKVAL<float>(4);
-            E->Push(obj->GetDistance(X, Y, Z));
+            ElunaPosition pos;
+            E->CHECKPOS(2, pos);
+            E->Push(obj->GetDistance(pos.x, pos.y, pos.z));
         }
         return 1;
     }
@@ -456,11 +468,13 @@ namespace LuaWorldObject
      *
      * @proto dist = (obj)
      * @proto dist = (x, y, z)
+     * @proto dist = (pos)
      *
      * @param [WorldObject] obj
      * @param float x : the X-coordinate of the point
      * @param float y : the Y-coordinate of the point
      * @param float z : the Z-coordinate of the point
+     * @param [Position] pos : the point
      *
      * @return float dist : the distance in yards
      */
@@ -479,9 +493,11 @@ namespace LuaWorldObject
         }
         else
         {
-            x -= E->CHECKVAL<float>(2);
-            y -= E->CHECKVAL<float>(3);
-            z -= E->CHECKVAL<float>(4);
+            ElunaPosition pos;
+            E->CHECKPOS(2, pos);
+            x -= pos.x;
+            y -= pos.y;
+            z -= pos.z;
         }
 
         E->Push(std::sqrt(x*x + y*y + z*z));
@@ -583,10 +599,12 @@ namespace LuaWorldObject
      *
      * @proto dist = (obj)
      * @proto dist = (x, y)
+     * @proto dist = (pos)
      *
      * @param [WorldObject] object
      * @param float x
      * @param float y
+     * @param [Position] pos
      *
      * @return float angle : angle in radians in range 0..2*pi
      */
@@ -598,8 +616,9 @@ namespace LuaWorldObject
             E->Push(obj->GetAbsoluteAngle(target));
         else
         {
-            float x = E->CHECKVAL<float>(2);
-            float y = E->CHECKVAL<float>(3);
+            ElunaPosition* pos = E->CHECKOBJ<ElunaPosition>(2, false);
+            float x = pos ? pos->x : E->CHECKVAL<float>(2);
+            float y = pos ? pos->y : E->CHECKVAL<float>(3);
             E->Push(obj->GetAbsoluteAngle(x, y));
         }
 
@@ -622,22 +641,28 @@ namespace LuaWorldObject
     /**
      * Spawns a [GameObject] at specified location.
      *
+     * @proto gameObject = (entry, x, y, z, o, respawnDelay)
+     * @proto gameObject = (entry, pos, respawnDelay)
+     *
      * @param uint32 entry : [GameObject] entry ID
      * @param float x
      * @param float y
      * @param float z
      * @param float o
+     * @param [Position] pos
      * @param uint32 respawnDelay = 30 : respawn time in seconds
      * @return [GameObject] gameObject
      */
     int SummonGameObject(Eluna* E, WorldObject* obj)
     {
         uint32 entry = E->CHECKVAL<uint32>(2);
-        float x = E->CHECKVAL<float>(3);
-        float y = E->CHECKVAL<float>(4);
-        float z = E->CHECKVAL<float>(5);
-        float o = E->CHECKVAL<float>(6);
-        uint32 respawnDelay = E->CHECKVAL<uint32>(7, 30);
+        ElunaPosition pos;
+        int narg = E->CHECKPOS(3, pos, true);
+        float x = pos.x;
+        float y = pos.y;
+        float z = pos.z;
+        float o = pos.o;
+        uint32 respawnDelay = E->CHECKVAL<uint32>(narg, 30);
 
         E->Push(obj->SummonGameObject(entry, x, y, z, o, 0, 0, 0, 0, respawnDelay));
         return 1;
@@ -659,11 +684,15 @@ namespace LuaWorldObject
      * @values [TEMPSUMMON_TIMED_OOC_OR_CORPSE_DESPAWN, 9, "despawns after a specified time (OOC) OR when the creature dies"]
      * @values [TEMPSUMMON_TIMED_OOC_OR_DEAD_DESPAWN, 10, "despawns after a specified time (OOC) OR when the creature disappears"]
      *
+     * @proto spawnedCreature = (entry, x, y, z, o, spawnType, despawnTimer)
+     * @proto spawnedCreature = (entry, pos, spawnType, despawnTimer)
+     *
      * @param uint32 entry : [Creature]'s entry ID
      * @param float x
      * @param float y
      * @param float z
      * @param float o
+     * @param [Position] pos
      * @param [TempSummonType] spawnType = MANUAL_DESPAWN : defines how and when the creature despawns
      * @param uint32 despawnTimer = 0 : despawn time in milliseconds
      * @return [Creature] spawnedCreature
@@ -671,12 +700,14 @@ namespace LuaWorldObject
     int SpawnCreature(Eluna* E, WorldObject* obj)
     {
         uint32 entry = E->CHECKVAL<uint32>(2);
-        float x = E->CHECKVAL<float>(3);
-        float y = E->CHECKVAL<float>(4);
-        float z = E->CHECKVAL<float>(5);
-        float o = E->CHECKVAL<float>(6);
-        uint32 spawnType = E->CHECKVAL<uint32>(7, 8);
-        uint32 despawnTimer = E->CHECKVAL<uint32>(8, 0);
+        ElunaPosition pos;
+        int narg = E->CHECKPOS(3, pos, true);
+        float x = pos.x;
+        float y = pos.y;
+        float z = pos.z;
+        float o = pos.o;
+        uint32 spawnType = E->CHECKVAL<uint32>(narg, 8);
+        uint32 despawnTimer = E->CHECKVAL<uint32>(narg + 1, 0);
 
         TempSummonType type;
         switch (spawnType)
@@ -706,7 +737,7 @@ namespace LuaWorldObject
                 type = TEMPSUMMON_MANUAL_DESPAWN;
                 break;
             default:
-                return luaL_argerror(E->L, 7, "valid SpawnType expected");
+                return luaL_argerror(E->L, narg, "valid SpawnType expected");
         }
 
         E->Push(obj->SummonCreature(entry, x, y, z, o, type, despawnTimer));
@@ -720,22 +751,27 @@ namespace LuaWorldObject
      *
      * Note that for [Creature] and [GameObject] the timed event timer ticks only if the creature is in sight of someone
      * For all [WorldObject]s the timed events are removed when the object is destoryed. This means that for example a [Player]'s events are removed on logout.
+     * Repeating events with a fixed delay are spread over it when `Eluna.SpreadRepeatingEvents` is enabled, see [Global:CreateLuaEvent].
      *
      *     local function Timed(eventid, delay, repeats, worldobject)
      *         print(worldobject:GetName())
      *     end
      *     worldobject:RegisterEvent(Timed, 1000, 5) -- do it after 1 second 5 times
      *     worldobject:RegisterEvent(Timed, {1000, 10000}, 0) -- do it after 1 to 10 seconds forever
+     *     worldobject:RegisterEvent(Timed, 1000, 0, 1000) -- do it every second forever, first after 1 to 2 seconds
      *
      * @proto eventId = (function, delay)
      * @proto eventId = (function, delaytable)
      * @proto eventId = (function, delay, repeats)
      * @proto eventId = (function, delaytable, repeats)
+     * @proto eventId = (function, delay, repeats, jitter)
+     * @proto eventId = (function, delaytable, repeats, jitter)
      *
      * @param function function : function to trigger when the time has passed
      * @param uint32 delay : set time in milliseconds for the event to trigger
      * @param table delaytable : a table `{min, max}` containing the minimum and maximum delay time
      * @param uint32 repeats = 1 : how many times for the event to repeat, 0 is infinite
+     * @param uint32 jitter = 0 : the first call is delayed by a random time up to this many milliseconds, which spreads events that are registered together
      * @return int eventId : unique ID for the timed event used to cancel it or nil
      */
     int RegisterEvent(Eluna* E, WorldObject* obj)
@@ -755,6 +791,7 @@ namespace LuaWorldObject
         else
             min = max = E->CHECKVAL<uint32>(3);
         uint32 repeats = E->CHECKVAL<uint32>(4, 1);
+        uint32 jitter = E->CHECKVAL<uint32>(5, 0);
 
         if (min > max)
             return luaL_argerror(E->L, 3, "min is bigger than max delay");
@@ -763,12 +800,43 @@ namespace LuaWorldObject
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef != LUA_REFNIL && functionRef != LUA_NOREF)
         {
-            obj->GetElunaEvents(E->GetBoundMapId())->AddEvent(functionRef, min, max, repeats);
+            obj->GetElunaEvents(E->GetBoundMapId())->AddEvent(functionRef, min, max, repeats, jitter);
             E->Push(functionRef);
         }
         return 1;
     }
 
+    /**
+     * Starts a coroutine of the [WorldObject] that can wait with `Sleep` and `WaitUntil`, see [Global:StartCoroutine].
+     *
+     * The coroutine waits like a timed event of the [WorldObject]. It is dropped when the object is destroyed,
+     *   and it is not resumed while the object is not in the world.
+     *
+     *     creature:StartCoroutine(function(creature)
+     *         creature:SendUnitSay("You are not prepared!", 0)
+     *         Sleep(3000)
+     *         creature:SetReactState(2)
+     *     end, creature)
+     *
+     * @param function function : function to run as a coroutine
+     * @param ... : the arguments passed to the function
+     * @return int eventId : unique ID of the coroutine, or nil if it ended without waiting
+     */
+    int StartCoroutine(Eluna* E, WorldObject* obj)
+    {
+        luaL_checktype(E->L, 2, LUA_TFUNCTION);
+
+        ElunaEventProcessor* proc = obj->GetElunaEvents(E->GetBoundMapId());
+        if (!proc)
+        {
+            E->Push();
+            return 1;
+        }
+
+        E->StartCoroutine(proc, 2);
+        return 1;
+    }
+
     /**
      * Removes the timed event from a [WorldObject] by the specified event ID
      *
@@ -1137,6 +1205,7 @@ namespace LuaWorldObject
         { "GetZ", &LuaWorldObject::GetZ },
         { "GetO", &LuaWorldObject::GetO },
         { "GetLocation", &LuaWorldObject::GetLocation },
+        { "GetPosition", &LuaWorldObject::GetPosition },
         { "GetPlayersInRange", &LuaWorldObject::GetPlayersInRange },
         { "GetCreaturesInRange", &LuaWorldObject::GetCreaturesInRange },
         { "GetGameObjectsInRange", &LuaWorldObject::GetGameObjectsInRange },
@@ -1170,6 +1239,7 @@ namespace LuaWorldObject
         { "SpawnCreature", &LuaWorldObject::SpawnCreature },
         { "SendPacket", &LuaWorldObject::SendPacket },
         { "RegisterEvent", &LuaWorldObject::RegisterEvent },
+        { "StartCoroutine", &LuaWorldObject::StartCoroutine },
         { "RemoveEventById", &LuaWorldObject::RemoveEventById },
         { "RemoveEvents", &LuaWorldObject::RemoveEvents },
         { "PlayMusic", &LuaWorldObject::PlayMusic },
@@ -115,6 +115,119 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
+    /**
+     * Returns the Lua time and load shedding statistics of the current state.
+     *
+     * When `Eluna.TickBudget` (in microseconds) is set, the Lua time of each tick is measured. If a tick used more than
+     * the budget, handlers registered with the `cosmetic` priority are skipped during the next tick.
+     * Only handlers of events whose return values are ignored are skipped, so a handler that can change
+     * the outcome of an event (e.g. by returning `false`) always runs. `normal` and `critical` handlers always run.
+     *
+     * The priority is passed to any Register*Event function after `shots`, for example
+     * `RegisterPlayerEvent(event, function, 0, eventPriority.cosmetic)`, and defaults to `normal`.
+     *
+     * The same budget also limits the timed events and async query callbacks run in a tick, as does `Eluna.UpdateCallLimit`
+     * (a number of calls). They stop when either limit is reached. The work left is carried over to the next tick in order of its due time.
+     *
+     * The returned table has the fields `tickTime` (Lua time of the last tick in microseconds), `budget` (in microseconds),
+     * `overrunTicks`, `shedding` (whether handlers are currently skipped) and `shed`, which maps each priority name
+     * to the amount of skipped handler calls.
+     * `carriedTimers` is the amount of objects with due timed events and `carriedCallbacks` the amount of query callbacks
+     * the last tick left over, `maxCarriedTimers` and `maxCarriedCallbacks` are the most left over by a tick and
+     * `carryOverTicks` is the amount of ticks that left work over.
+     *
+     * @return table stats
+     */
+    int GetLuaLoadStats(Eluna* E)
+    {
+        E->PushLoadStats();
+        return 1;
+    }
+
+    /**
+     * Returns the call counts and timings of the C++ methods called in the current state.
+     *
+     * Methods are only measured while method profiling is enabled, either with `Eluna.MethodProfiling` in the
+     * configuration file or with [SetMethodProfiling]. Calls that raise a Lua error are not counted.
+     *
+     * The returned array is sorted by total time, slowest first. Each entry has the fields `type` (the class name,
+     * or "Global" for global functions), `method`, `calls` and `time` (total time in nanoseconds).
+     *
+     * @return table stats
+     */
+    int GetMethodStats(Eluna* E)
+    {
+        E->PushMethodStats();
+        return 1;
+    }
+
+    /**
+     * Writes the method call counts and timings of the current state to a CSV file.
+     *
+     * The columns are `type`, `method`, `calls`, `time_ns` and `avg_ns`. An existing file is overwritten.
+     *
+     * @param string path : path of the file to write
+     * @return bool written : true if the file was written
+     */
+    int DumpMethodStats(Eluna* E)
+    {
+        std::string path = E->CHECKVAL<std::string>(1);
+
+        E->Push(E->DumpMethodStats(path));
+        return 1;
+    }
+
+    /**
+     * Enables or disables method profiling in the current state, see [GetMethodStats].
+     *
+     * The collected statistics are kept when profiling is disabled.
+     *
+     * @param bool enable = true
+     */
+    int SetMethodProfiling(Eluna* E)
+    {
+        bool enable = E->CHECKVAL<bool>(1, true);
+
+        E->SetMethodProfiling(enable);
+        return 0;
+    }
+
+    /**
+     * Clears the method call counts and timings of the current state.
+     */
+    int ResetMethodStats(Eluna* E)
+    {
+        E->ResetMethodStats();
+        return 0;
+    }
+
+    /**
+     * Returns the allocation statistics of the timed events of the current state.
+     *
+     * Timed events are allocated from chunks that are reused, these statistics show how many events are created and
+     * destroyed over time. The returned table has the fields `live` (events that exist now), `peak` (most events that existed
+     * at once), `capacity` (events that fit in the allocated chunks), `allocations` and `frees` (events created and destroyed in total).
+     *
+     * @return table stats
+     */
+    int GetTimedEventStats(Eluna* E)
+    {
+        LuaEventPool::Stats const& stats = E->eventMgr->GetEventPoolStats();
+
+        lua_createtable(E->L, 0, 5);
+        E->Push(stats.live);
+        lua_setfield(E->L, -2, "live");
+        E->Push(stats.peak);
+        lua_setfield(E->L, -2, "peak");
+        E->Push(stats.capacity);
+        lua_setfield(E->L, -2, "capacity");
+        E->Push(stats.allocations);
+        lua_setfield(E->L, -2, "allocations");
+        E->Push(stats.frees);
+        lua_setfield(E->L, -2, "frees");
+        return 1;
+    }
+
     /**
      * Returns [Quest] template
      *
@@ -558,11 +671,14 @@ namespace LuaGlobalFunctions
         uint32 ev = E->CHECKVAL<uint32>(2);
         luaL_checktype(E->L, 3, LUA_TFUNCTION);
         uint32 shots = E->CHECKVAL<uint32>(4, 0);
+        uint32 priority = E->CHECKVAL<uint32>(5, Hooks::BINDING_PRIORITY_NORMAL);
+        if (priority >= Hooks::BINDING_PRIORITY_COUNT)
+            return luaL_argerror(E->L, 5, "valid binding priority expected");
 
         lua_pushvalue(E->L, 3);
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return E->Register(regtype, id, ObjectGuid(), 0, ev, functionRef, shots);
+            return E->Register(regtype, id, ObjectGuid(), 0, ev, functionRef, shots, priority);
         else
             luaL_argerror(E->L, 3, "unable to make a ref to function");
         return 0;
@@ -573,11 +689,14 @@ namespace LuaGlobalFunctions
         uint32 ev = E->CHECKVAL<uint32>(1);
         luaL_checktype(E->L, 2, LUA_TFUNCTION);
         uint32 shots = E->CHECKVAL<uint32>(3, 0);
+        uint32 priority = E->CHECKVAL<uint32>(4, Hooks::BINDING_PRIORITY_NORMAL);
+        if (priority >= Hooks::BINDING_PRIORITY_COUNT)
+            return luaL_argerror(E->L, 4, "valid binding priority expected");
 
         lua_pushvalue(E->L, 2);
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return E->Register(regtype, 0, ObjectGuid(), 0, ev, functionRef, shots);
+            return E->Register(regtype, 0, ObjectGuid(), 0, ev, functionRef, shots, priority);
         else
             luaL_argerror(E->L, 2, "unable to make a ref to function");
         return 0;
@@ -590,11 +709,14 @@ namespace LuaGlobalFunctions
         uint32 ev = E->CHECKVAL<uint32>(3);
         luaL_checktype(E->L, 4, LUA_TFUNCTION);
         uint32 shots = E->CHECKVAL<uint32>(5, 0);
+        uint32 priority = E->CHECKVAL<uint32>(6, Hooks::BINDING_PRIORITY_NORMAL);
+        if (priority >= Hooks::BINDING_PRIORITY_COUNT)
+            return luaL_argerror(E->L, 6, "valid binding priority expected");
 
         lua_pushvalue(E->L, 4);
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return E->Register(regtype, 0, guid, instanceId, ev, functionRef, shots);
+            return E->Register(regtype, 0, guid, instanceId, ev, functionRef, shots, priority);
         else
             luaL_argerror(E->L, 4, "unable to make a ref to function");
         return 0;
@@ -663,10 +785,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : server event ID, refer to ServerEvents above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -732,8 +856,8 @@ namespace LuaGlobalFunctions
      *     PLAYER_EVENT_ON_UPDATE_AREA             =     47,       // (event, player, oldArea, newArea)
      *     PLAYER_EVENT_ON_TRADE_INIT              =     48,       // (event, player, target) - Can return false to interrupt trade
      *     PLAYER_EVENT_ON_SEND_MAIL               =     49,       // (event, player, recipientGuid) - Can return false to interrupt sending
-     *     // UNUSED                               =     50,       // (event, player)
-     *     // UNUSED                               =     51,       // (event, player)
+     *     PLAYER_EVENT_ON_LEAVE_ZONE              =     50,       // (event, player, oldZone, newZone) - Not called for the first zone seen after entering the map. newZone is 0 when the player leaves the map or logs out
+     *     PLAYER_EVENT_ON_LEAVE_AREA              =     51,       // (event, player, oldArea, newArea) - newArea is 0 when the player leaves the map or logs out
      *     // UNUSED                               =     52,       // (event, player)
      *     // UNUSED                               =     53,       // (event, player)
      *     PLAYER_EVENT_ON_QUEST_STATUS_CHANGED    =     54,       // (event, player, questId, status)
@@ -742,10 +866,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : [Player] event Id, refer to PlayerEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -754,6 +880,43 @@ namespace LuaGlobalFunctions
         return RegisterEventHelper(E, Hooks::REGTYPE_PLAYER);
     }
 
+    /**
+     * Registers a [Player] event handler for a single item, creature, spell, quest, zone or area ID.
+     *
+     * Only handlers registered for the ID involved in the event are called, so the handler is not entered for every loot, kill, learned spell or zone change on the server.
+     * Handlers registered with [Global:RegisterPlayerEvent] for the same event are still called as well.
+     *
+     * @hook player
+     * @table
+     * @columns [Event, Entry, Parameters]
+     * @values [PLAYER_EVENT_ON_KILL_CREATURE, "creature entry", <event: number, killer: Player, killed: Creature>]
+     * @values [PLAYER_EVENT_ON_EQUIP, "item entry", <event: number, player: Player, item: Item, bag: number, slot: number>]
+     * @values [PLAYER_EVENT_ON_LOOT_ITEM, "item entry", <event: number, player: Player, item: Item, count: number>]
+     * @values [PLAYER_EVENT_ON_QUEST_ABANDON, "quest ID", <event: number, player: Player, questId: number>]
+     * @values [PLAYER_EVENT_ON_LEARN_SPELL, "spell ID", <event: number, player: Player, spellId: number>]
+     * @values [PLAYER_EVENT_ON_QUEST_STATUS_CHANGED, "quest ID", <event: number, player: Player, questId: number, status: number>]
+     * @values [PLAYER_EVENT_ON_UPDATE_ZONE, "new zone ID", <event: number, player: Player, newZone: number, newArea: number>]
+     * @values [PLAYER_EVENT_ON_UPDATE_AREA, "new area ID", <event: number, player: Player, oldArea: number, newArea: number>]
+     * @values [PLAYER_EVENT_ON_LEAVE_ZONE, "old zone ID", <event: number, player: Player, oldZone: number, newZone: number>]
+     * @values [PLAYER_EVENT_ON_LEAVE_AREA, "old area ID", <event: number, player: Player, oldArea: number, newArea: number>]
+     *
+     * @proto cancel = (entry, event, function)
+     * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     *
+     * @param uint32 entry : the item entry, creature entry, spell, quest, zone or area ID to bind to, refer to table above
+     * @param uint32 event : [Player] event Id, refer to table above
+     * @param function function : function to register
+     * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
+     *
+     * @return function cancel : a function that cancels the binding when called
+     */
+    int RegisterPlayerEntryEvent(Eluna* E)
+    {
+        return RegisterEntryHelper(E, Hooks::REGTYPE_PLAYER_ENTRY);
+    }
+
     /**
      * Registers a [Guild] event handler.
      *
@@ -779,10 +942,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : [Guild] event Id, refer to GuildEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -812,10 +977,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : [Group] event Id, refer to GroupEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -840,10 +1007,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : [BattleGround] event Id, refer to BGEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -868,11 +1037,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : opcode
      * @param uint32 event : packet event Id, refer to PacketEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -895,11 +1066,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [Creature] entry Id
      * @param uint32 event : [Creature] gossip event Id, refer to GossipEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -922,11 +1095,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [GameObject] entry Id
      * @param uint32 event : [GameObject] gossip event Id, refer to GossipEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -935,6 +1110,64 @@ namespace LuaGlobalFunctions
         return RegisterEntryHelper(E, Hooks::REGTYPE_GAMEOBJECT_GOSSIP);
     }
 
+    /**
+     * Registers a static gossip menu for a [Creature] entry, replacing any previous one.
+     *
+     * The menu is stored on the C++ side and shown on gossip hello without calling Lua.
+     * Selecting an option opens its submenu, teleports the [Player] or closes the gossip,
+     * and only options with a `callback` enter Lua. While a static menu is registered,
+     * gossip events registered with [Global:RegisterCreatureGossipEvent] are not called for the entry.
+     *
+     * The menu maps page IDs to pages, page 1 is shown on gossip hello.
+     * A page has an npc_text ID `text` and a list of `items`.
+     * An item has a `text` and optionally an `icon`, the conditions `level` (minimum level), `class`, `money` (minimum copper)
+     * and `quest` with `questStatus` (defaults to incomplete), and one action: `callback`, `menu` (page ID) or `teleport`.
+     * The callback is called as `callback(player, object, page, option)` after the gossip is closed.
+     *
+     * <pre>
+     * RegisterCreatureGossipMenu(entry, {
+     *     [1] = { text = 1, items = {
+     *         { icon = 2, text = "Take me to Stormwind", level = 10, teleport = { map = 0, x = -8913.2, y = 554.6, z = 93.8, o = 0.6 } },
+     *         { icon = 0, text = "Tell me more", menu = 2 },
+     *     } },
+     *     [2] = { text = 2, items = {
+     *         { icon = 0, text = "Thanks", callback = function(player, creature) player:SendBroadcastMessage("Good luck!") end },
+     *     } },
+     * })
+     * </pre>
+     *
+     * @param uint32 entry : [Creature] entry Id
+     * @param table menu : the menu pages, see above
+     */
+    int RegisterCreatureGossipMenu(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        luaL_checktype(E->L, 2, LUA_TTABLE);
+
+        if (const char* error = E->RegisterGossipMenu(TYPEID_UNIT, entry, 2))
+            return luaL_argerror(E->L, 2, error);
+        return 0;
+    }
+
+    /**
+     * Registers a static gossip menu for a [GameObject] entry, replacing any previous one.
+     *
+     * The menu format is the same as for [Global:RegisterCreatureGossipMenu].
+     * While a static menu is registered, gossip events registered with [Global:RegisterGameObjectGossipEvent] are not called for the entry.
+     *
+     * @param uint32 entry : [GameObject] entry Id
+     * @param table menu : the menu pages, see [Global:RegisterCreatureGossipMenu]
+     */
+    int RegisterGameObjectGossipMenu(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        luaL_checktype(E->L, 2, LUA_TTABLE);
+
+        if (const char* error = E->RegisterGossipMenu(TYPEID_GAMEOBJECT, entry, 2))
+            return luaL_argerror(E->L, 2, error);
+        return 0;
+    }
+
     /**
      * Registers an [Item] event handler.
      *
@@ -955,11 +1188,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [Item] entry Id
      * @param uint32 event : [Item] event Id, refer to ItemEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -982,11 +1217,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [Item] entry Id
      * @param uint32 event : [Item] gossip event Id, refer to GossipEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1016,6 +1253,7 @@ namespace LuaGlobalFunctions
      * @param uint32 event : [Map] event ID, refer to MapEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      */
     int RegisterMapEvent(Eluna* E)
     {
@@ -1043,6 +1281,7 @@ namespace LuaGlobalFunctions
      * @param uint32 event : [Map] event ID, refer to MapEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      */
     int RegisterInstanceEvent(Eluna* E)
     {
@@ -1065,11 +1304,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (menu_id, event, function)
      * @proto cancel = (menu_id, event, function, shots)
+     * @proto cancel = (menu_id, event, function, shots, priority)
      *
      * @param uint32 menu_id : [Player] gossip menu Id
      * @param uint32 event : [Player] gossip event Id, refer to GossipEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1127,11 +1368,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : the ID of one or more [Creature]s
      * @param uint32 event : refer to CreatureEvents above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1189,12 +1432,14 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (guid, instance_id, event, function)
      * @proto cancel = (guid, instance_id, event, function, shots)
+     * @proto cancel = (guid, instance_id, event, function, shots, priority)
      *
      * @param ObjectGuid guid : the GUID of a single [Creature]
      * @param uint32 instance_id : the instance ID of a single [Creature]
      * @param uint32 event : refer to CreatureEvents above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1229,11 +1474,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [GameObject] entry Id
      * @param uint32 event : [GameObject] event Id, refer to GameObjectEvents above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1564,15 +1811,21 @@ namespace LuaGlobalFunctions
      *
      * Repeats will decrease on each call if the event does not repeat indefinitely
      *
+     * When `Eluna.SpreadRepeatingEvents` is enabled, repeating events with a fixed delay and no jitter have their first call
+     * delayed so that the events of the same delay are spread evenly over it, instead of all being called on the same tick.
+     *
      * @proto eventId = (function, delay)
      * @proto eventId = (function, delaytable)
      * @proto eventId = (function, delay, repeats)
      * @proto eventId = (function, delaytable, repeats)
+     * @proto eventId = (function, delay, repeats, jitter)
+     * @proto eventId = (function, delaytable, repeats, jitter)
      *
      * @param function function : function to trigger when the time has passed
      * @param uint32 delay : set time in milliseconds for the event to trigger
      * @param table delaytable : a table `{min, max}` containing the minimum and maximum delay time
      * @param uint32 repeats = 1 : how many times for the event to repeat, 0 is infinite
+     * @param uint32 jitter = 0 : the first call is delayed by a random time up to this many milliseconds, which spreads events that are registered together
      * @return int eventId : unique ID for the timed event used to cancel it or nil
      */
     int CreateLuaEvent(Eluna* E)
@@ -1592,6 +1845,7 @@ namespace LuaGlobalFunctions
         else
             min = max = E->CHECKVAL<uint32>(2);
         uint32 repeats = E->CHECKVAL<uint32>(3, 1);
+        uint32 jitter = E->CHECKVAL<uint32>(4, 0);
 
         if (min > max)
             return luaL_argerror(E->L, 2, "min is bigger than max delay");
@@ -1600,12 +1854,42 @@ namespace LuaGlobalFunctions
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef != LUA_REFNIL && functionRef != LUA_NOREF)
         {
-            E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS)->AddEvent(functionRef, min, max, repeats);
+            E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS)->AddEvent(functionRef, min, max, repeats, jitter);
             E->Push(functionRef);
         }
         return 1;
     }
 
+    /**
+     * Starts a coroutine that can wait with `Sleep` and `WaitUntil` instead of nesting timed events.
+     *
+     * The function is called with the extra arguments right away and runs until it waits or ends.
+     * `Sleep(ms)` suspends it for `ms` milliseconds. `WaitUntil(predicate, timeout, interval)` suspends it until `predicate` returns true,
+     * which is checked every `interval` milliseconds (every update by default) without resuming the coroutine.
+     * WaitUntil returns false if `timeout` milliseconds (0 for none) pass first or the predicate raises an error.
+     * A plain `coroutine.yield(...)` waits for the next update, whatever values it yields.
+     *
+     * The coroutine waits like a global timed event and can be removed with [Global:RemoveEventById] using the returned ID.
+     * Coroutines of a [WorldObject] are started with [WorldObject:StartCoroutine].
+     *
+     *     StartCoroutine(function(text)
+     *         print(text)
+     *         Sleep(1000)
+     *         local ok = WaitUntil(function() return GetPlayerCount() > 0 end, 60000, 500)
+     *         print(ok and "a player logged in" or "nobody logged in")
+     *     end, "started")
+     *
+     * @param function function : function to run as a coroutine
+     * @param ... : the arguments passed to the function
+     * @return int eventId : unique ID of the coroutine, or nil if it ended without waiting
+     */
+    int StartCoroutine(Eluna* E)
+    {
+        luaL_checktype(E->L, 1, LUA_TFUNCTION);
+        E->StartCoroutine(E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS), 1);
+        return 1;
+    }
+
     /**
      * Removes a global timed event specified by ID.
      *
@@ -2672,6 +2956,26 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
+    /**
+     * Returns a new [Position] with the given coordinates and orientation.
+     *
+     * @param float x = 0
+     * @param float y = 0
+     * @param float z = 0
+     * @param float o = 0 : orientation
+     * @return [Position] pos
+     */
+    int CreatePosition(Eluna* E)
+    {
+        float x = E->CHECKVAL<float>(1, 0.0f);
+        float y = E->CHECKVAL<float>(2, 0.0f);
+        float z = E->CHECKVAL<float>(3, 0.0f);
+        float o = E->CHECKVAL<float>(4, 0.0f);
+
+        E->Push(ElunaPosition(x, y, z, o));
+        return 1;
+    }
+
     /**
      * Unbinds event handlers for either all [BattleGround] events, or one type of event.
      *
@@ -2883,6 +3187,32 @@ namespace LuaGlobalFunctions
         return 0;
     }
 
+    /**
+     * Removes the static gossip menu of a [Creature] entry, see [Global:RegisterCreatureGossipMenu].
+     *
+     * @param uint32 entry : [Creature] entry Id
+     */
+    int ClearCreatureGossipMenu(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+
+        E->ClearGossipMenu(TYPEID_UNIT, entry);
+        return 0;
+    }
+
+    /**
+     * Removes the static gossip menu of a [GameObject] entry, see [Global:RegisterGameObjectGossipMenu].
+     *
+     * @param uint32 entry : [GameObject] entry Id
+     */
+    int ClearGameObjectGossipMenu(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+
+        E->ClearGossipMenu(TYPEID_GAMEOBJECT, entry);
+        return 0;
+    }
+
     /**
      * Unbinds event handlers for either all [Group] events, or one type of [Group] event.
      *
@@ -3072,6 +3402,39 @@ namespace LuaGlobalFunctions
         return 0;
     }
 
+    /**
+     * Unbinds event handlers for either all [Player] events bound to an entry, or one type of event.
+     *
+     * If `event_type` is `nil`, all [Player] event handlers bound to `entry` are cleared.
+     *
+     * Otherwise, only event handlers for `event_type` are cleared.
+     *
+     * @proto (entry)
+     * @proto (entry, event_type)
+     * @param uint32 entry : the item entry, creature entry, spell, quest, zone or area ID whose handlers will be cleared
+     * @param uint32 event_type : the event whose handlers will be cleared, see [Global:RegisterPlayerEntryEvent]
+     */
+    int ClearPlayerEntryEvents(Eluna* E)
+    {
+        typedef EntryKey<Hooks::PlayerEvents> Key;
+        auto binding = E->GetBinding<Key>(Hooks::REGTYPE_PLAYER_ENTRY);
+
+        if (lua_isnoneornil(E->L, 2))
+        {
+            uint32 entry = E->CHECKVAL<uint32>(1);
+
+            for (uint32 i = 1; i < Hooks::PLAYER_EVENT_COUNT; ++i)
+                binding->Clear(Key((Hooks::PlayerEvents)i, entry));
+        }
+        else
+        {
+            uint32 entry = E->CHECKVAL<uint32>(1);
+            uint32 event_type = E->CHECKVAL<uint32>(2);
+            binding->Clear(Key((Hooks::PlayerEvents)event_type, entry));
+        }
+        return 0;
+    }
+
     /**
      * Unbinds event handlers for either all of a [Player]'s gossip events, or one type of event.
      *
@@ -3201,12 +3564,115 @@ namespace LuaGlobalFunctions
         return 0;
     }
 
+    /**
+     * Returns the read-only [ItemTemplate] of the item entry, or nil if the entry does not exist.
+     *
+     * The same userdata is returned for every call with the same entry.
+     *
+     * @param uint32 entry : the item entry
+     * @return [ItemTemplate] itemTemplate
+     */
+    int GetItemTemplateView(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        E->PushTemplateView(eObjectMgr->GetItemTemplate(entry));
+        return 1;
+    }
+
+    /**
+     * Returns a table with the read-only [ItemTemplate]s whose fields match the filter, in no particular order.
+     *
+     * Each filter field maps to a value or to an inclusive `{ min, max }` range, and a template
+     *   matches when all of the fields match. The name can't be filtered by.
+     * The templates are matched without entering Lua, so only the matching templates are pushed.
+     *
+     * @param table filter = nil : field names mapped to values or ranges, for example `{ class = 2, quality = 4, itemLevel = { 60, 70 } }`
+     * @return table itemTemplates
+     */
+    int GetItemTemplates(Eluna* E)
+    {
+        ElunaFieldFilter<ElunaItemTemplate> filter;
+        if (const char* error = filter.Load(E->L, 1, ElunaTemplate<ElunaItemTemplate>::GetFieldTable(LuaItemTemplate::ItemTemplateFields)))
+            return luaL_argerror(E->L, 1, error);
+
+        std::vector<ItemTemplate const*> matches;
+        for (uint32 id = 0; id < sItemStorage.GetMaxEntry(); ++id)
+        {
+            ItemPrototype const* pProto = sItemStorage.LookupEntry<ItemPrototype>(id);
+            if (!pProto)
+                continue;
+
+            ElunaItemTemplate view(pProto);
+            if (filter.Matches(&view))
+                matches.push_back(pProto);
+        }
+
+        lua_createtable(E->L, static_cast<int>(matches.size()), 0);
+        for (size_t i = 0; i < matches.size(); ++i)
+        {
+            E->PushTemplateView(matches[i]);
+            lua_rawseti(E->L, -2, static_cast<int>(i + 1));
+        }
+        return 1;
+    }
+
+    /**
+     * Returns the read-only [CreatureTemplate] of the creature entry, or nil if the entry does not exist.
+     *
+     * The same userdata is returned for every call with the same entry.
+     *
+     * @param uint32 entry : the creature entry
+     * @return [CreatureTemplate] creatureTemplate
+     */
+    int GetCreatureTemplateView(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        E->PushTemplateView(eObjectMgr->GetCreatureTemplate(entry));
+        return 1;
+    }
+
+    /**
+     * Returns a table with the read-only [CreatureTemplate]s whose fields match the filter, in no particular order.
+     *
+     * The filter works like the filter of [GetItemTemplates].
+     *
+     * @param table filter = nil : field names mapped to values or ranges, for example `{ type = 1, rank = { 1, 3 } }`
+     * @return table creatureTemplates
+     */
+    int GetCreatureTemplates(Eluna* E)
+    {
+        ElunaFieldFilter<ElunaCreatureTemplate> filter;
+        if (const char* error = filter.Load(E->L, 1, ElunaTemplate<ElunaCreatureTemplate>::GetFieldTable(LuaCreatureTemplate::CreatureTemplateFields)))
+            return luaL_argerror(E->L, 1, error);
+
+        std::vector<CreatureTemplate const*> matches;
+        for (uint32 id = 0; id < sCreatureStorage.GetMaxEntry(); ++id)
+        {
+            CreatureInfo const* cInfo = sCreatureStorage.LookupEntry<CreatureInfo>(id);
+            if (!cInfo)
+                continue;
+
+            ElunaCreatureTemplate view(cInfo);
+            if (filter.Matches(&view))
+                matches.push_back(cInfo);
+        }
+
+        lua_createtable(E->L, static_cast<int>(matches.size()), 0);
+        for (size_t i = 0; i < matches.size(); ++i)
+        {
+            E->PushTemplateView(matches[i]);
+            lua_rawseti(E->L, -2, static_cast<int>(i + 1));
+        }
+        return 1;
+    }
+
     ElunaRegister<> GlobalMethods[] =
     {
         // Hooks
         { "RegisterPacketEvent", &LuaGlobalFunctions::RegisterPacketEvent },
         { "RegisterServerEvent", &LuaGlobalFunctions::RegisterServerEvent },
         { "RegisterPlayerEvent", &LuaGlobalFunctions::RegisterPlayerEvent },
+        { "RegisterPlayerEntryEvent", &LuaGlobalFunctions::RegisterPlayerEntryEvent },
         { "RegisterGuildEvent", &LuaGlobalFunctions::RegisterGuildEvent },
         { "RegisterGroupEvent", &LuaGlobalFunctions::RegisterGroupEvent },
         { "RegisterCreatureEvent", &LuaGlobalFunctions::RegisterCreatureEvent },
@@ -3214,6 +3680,8 @@ namespace LuaGlobalFunctions
         { "RegisterCreatureGossipEvent", &LuaGlobalFunctions::RegisterCreatureGossipEvent },
         { "RegisterGameObjectEvent", &LuaGlobalFunctions::RegisterGameObjectEvent },
         { "RegisterGameObjectGossipEvent", &LuaGlobalFunctions::RegisterGameObjectGossipEvent },
+        { "RegisterCreatureGossipMenu", &LuaGlobalFunctions::RegisterCreatureGossipMenu },
+        { "RegisterGameObjectGossipMenu", &LuaGlobalFunctions::RegisterGameObjectGossipMenu },
         { "RegisterItemEvent", &LuaGlobalFunctions::RegisterItemEvent },
         { "RegisterItemGossipEvent", &LuaGlobalFunctions::RegisterItemGossipEvent },
         { "RegisterPlayerGossipEvent", &LuaGlobalFunctions::RegisterPlayerGossipEvent },
@@ -3227,12 +3695,15 @@ namespace LuaGlobalFunctions
         { "ClearCreatureGossipEvents", &LuaGlobalFunctions::ClearCreatureGossipEvents },
         { "ClearGameObjectEvents", &LuaGlobalFunctions::ClearGameObjectEvents },
         { "ClearGameObjectGossipEvents", &LuaGlobalFunctions::ClearGameObjectGossipEvents },
+        { "ClearCreatureGossipMenu", &LuaGlobalFunctions::ClearCreatureGossipMenu },
+        { "ClearGameObjectGossipMenu", &LuaGlobalFunctions::ClearGameObjectGossipMenu },
         { "ClearGroupEvents", &LuaGlobalFunctions::ClearGroupEvents },
         { "ClearGuildEvents", &LuaGlobalFunctions::ClearGuildEvents },
         { "ClearItemEvents", &LuaGlobalFunctions::ClearItemEvents },
         { "ClearItemGossipEvents", &LuaGlobalFunctions::ClearItemGossipEvents },
         { "ClearPacketEvents", &LuaGlobalFunctions::ClearPacketEvents },
         { "ClearPlayerEvents", &LuaGlobalFunctions::ClearPlayerEvents },
+        { "ClearPlayerEntryEvents", &LuaGlobalFunctions::ClearPlayerEntryEvents },
         { "ClearPlayerGossipEvents", &LuaGlobalFunctions::ClearPlayerGossipEvents },
         { "ClearServerEvents", &LuaGlobalFunctions::ClearServerEvents },
         { "ClearMapEvents", &LuaGlobalFunctions::ClearMapEvents },
@@ -3247,6 +3718,12 @@ namespace LuaGlobalFunctions
         { "GetStateMap", &LuaGlobalFunctions::GetStateMap, METHOD_REG_MAP }, // Map state method only in multistate
         { "GetStateMapId", &LuaGlobalFunctions::GetStateMapId },
         { "GetStateInstanceId", &LuaGlobalFunctions::GetStateInstanceId },
+        { "GetLuaLoadStats", &LuaGlobalFunctions::GetLuaLoadStats },
+        { "GetMethodStats", &LuaGlobalFunctions::GetMethodStats },
+        { "DumpMethodStats", &LuaGlobalFunctions::DumpMethodStats },
+        { "SetMethodProfiling", &LuaGlobalFunctions::SetMethodProfiling },
+        { "ResetMethodStats", &LuaGlobalFunctions::ResetMethodStats },
+        { "GetTimedEventStats", &LuaGlobalFunctions::GetTimedEventStats },
         { "GetQuest", &LuaGlobalFunctions::GetQuest },
         { "GetPlayerByGUID", &LuaGlobalFunctions::GetPlayerByGUID, METHOD_REG_WORLD }, // World state method only in multistate
         { "GetPlayerByName", &LuaGlobalFunctions::GetPlayerByName, METHOD_REG_WORLD }, // World state method only in multistate
@@ -3278,6 +3755,10 @@ namespace LuaGlobalFunctions
         { "PrintError", &LuaGlobalFunctions::PrintError },
         { "PrintDebug", &LuaGlobalFunctions::PrintDebug },
         { "GetActiveGameEvents", &LuaGlobalFunctions::GetActiveGameEvents },
+        { "GetItemTemplateView", &LuaGlobalFunctions::GetItemTemplateView },
+        { "GetItemTemplates", &LuaGlobalFunctions::GetItemTemplates },
+        { "GetCreatureTemplateView", &LuaGlobalFunctions::GetCreatureTemplateView },
+        { "GetCreatureTemplates", &LuaGlobalFunctions::GetCreatureTemplates },
 
         // Boolean
         { "IsCompatibilityMode", &LuaGlobalFunctions::IsCompatibilityMode },
@@ -3301,6 +3782,7 @@ namespace LuaGlobalFunctions
         { "AuthDBExecute", &LuaGlobalFunctions::AuthDBExecute },
         { "AuthDBQueryAsync", &LuaGlobalFunctions::AuthDBQueryAsync, METHOD_REG_NONE }, // TODO: Implement
         { "CreateLuaEvent", &LuaGlobalFunctions::CreateLuaEvent },
+        { "StartCoroutine", &LuaGlobalFunctions::StartCoroutine },
         { "RemoveEventById", &LuaGlobalFunctions::RemoveEventById },
         { "RemoveEvents", &LuaGlobalFunctions::RemoveEvents },
         { "PerformIngameSpawn", &LuaGlobalFunctions::PerformIngameSpawn },
@@ -3315,6 +3797,7 @@ namespace LuaGlobalFunctions
         { "AddTaxiPath", &LuaGlobalFunctions::AddTaxiPath },
         { "CreateInt64", &LuaGlobalFunctions::CreateLongLong },
         { "CreateUint64", &LuaGlobalFunctions::CreateULongLong },
+        { "CreatePosition", &LuaGlobalFunctions::CreatePosition },
         { "StartGameEvent", &LuaGlobalFunctions::StartGameEvent },
         { "StopGameEvent", &LuaGlobalFunctions::StopGameEvent }
     };
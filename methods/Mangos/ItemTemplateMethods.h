@@ -0,0 +1,47 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef ITEMTEMPLATEMETHODS_H
+#define ITEMTEMPLATEMETHODS_H
+
+/***
+ * Read-only view of an item template, shared by all scripts of the state.
+ *
+ * The template's fields are read directly, for example `template.quality`, and the same
+ *   userdata is returned for every lookup of the same template.
+ * Use [GetItemTemplateView] to get the template of an entry and [GetItemTemplates] to find templates by their fields.
+ *
+ * Fields: `entry`, `name`, `class`, `subClass`, `quality`, `displayId`, `flags`, `buyCount`, `buyPrice`, `sellPrice`, `inventoryType`, `allowableClass`, `allowableRace`, `itemLevel`, `requiredLevel`, `maxCount`, `stackable`, `bonding`, `itemSet`, `startQuest`.
+ *
+ * Inherits all methods from: none
+ */
+namespace LuaItemTemplate
+{
+    ElunaField<ElunaItemTemplate> const ItemTemplateFields[] =
+    {
+        ELUNA_FIELD(ElunaItemTemplate, "entry", obj->Get()->ItemId),
+        ELUNA_STRING_FIELD(ElunaItemTemplate, "name", obj->Get()->Name1),
+        ELUNA_FIELD(ElunaItemTemplate, "class", obj->Get()->Class),
+        ELUNA_FIELD(ElunaItemTemplate, "subClass", obj->Get()->SubClass),
+        ELUNA_FIELD(ElunaItemTemplate, "quality", obj->Get()->Quality),
+        ELUNA_FIELD(ElunaItemTemplate, "displayId", obj->Get()->DisplayInfoID),
+        ELUNA_FIELD(ElunaItemTemplate, "flags", obj->Get()->Flags),
+        ELUNA_FIELD(ElunaItemTemplate, "buyCount", obj->Get()->BuyCount),
+        ELUNA_FIELD(ElunaItemTemplate, "buyPrice", obj->Get()->BuyPrice),
+        ELUNA_FIELD(ElunaItemTemplate, "sellPrice", obj->Get()->SellPrice),
+        ELUNA_FIELD(ElunaItemTemplate, "inventoryType", obj->Get()->InventoryType),
+        ELUNA_FIELD(ElunaItemTemplate, "allowableClass", obj->Get()->AllowableClass),
+        ELUNA_FIELD(ElunaItemTemplate, "allowableRace", obj->Get()->AllowableRace),
+        ELUNA_FIELD(ElunaItemTemplate, "itemLevel", obj->Get()->ItemLevel),
+        ELUNA_FIELD(ElunaItemTemplate, "requiredLevel", obj->Get()->RequiredLevel),
+        ELUNA_FIELD(ElunaItemTemplate, "maxCount", obj->Get()->MaxCount),
+        ELUNA_FIELD(ElunaItemTemplate, "stackable", obj->Get()->Stackable),
+        ELUNA_FIELD(ElunaItemTemplate, "bonding", obj->Get()->Bonding),
+        ELUNA_FIELD(ElunaItemTemplate, "itemSet", obj->Get()->ItemSet),
+        ELUNA_FIELD(ElunaItemTemplate, "startQuest", obj->Get()->StartQuest),
+    };
+};
+#endif
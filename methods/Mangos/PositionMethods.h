@@ -0,0 +1,199 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef POSITIONMETHODS_H
+#define POSITIONMETHODS_H
+
+/***
+ * Coordinates and orientation as a single value, created with [CreatePosition] or [WorldObject:GetPosition].
+ *
+ * Positions can be passed to methods that take coordinates instead of the x, y and z numbers, for example
+ *   `creature:MoveTo(0, pos)` or `obj:GetDistance(pos)`.
+ *
+ * The coordinates are read directly as `pos.x`, `pos.y`, `pos.z` and `pos.o` and can't be changed, operations return a new [Position].
+ * `pos + other` and `pos - other` add and subtract the coordinates, `pos * number` and `pos / number` scale them
+ *   and the orientation of `pos` is kept. The number has to come after the [Position], `number * pos` raises an error.
+ * `pos == other` compares the coordinates and the orientation.
+ *
+ * Fields: `x`, `y`, `z`, `o`.
+ *
+ * Inherits all methods from: none
+ */
+namespace LuaPosition
+{
+    ElunaField<ElunaPosition> const PositionFields[] =
+    {
+        ELUNA_FIELD(ElunaPosition, "x", obj->x),
+        ELUNA_FIELD(ElunaPosition, "y", obj->y),
+        ELUNA_FIELD(ElunaPosition, "z", obj->z),
+        ELUNA_FIELD(ElunaPosition, "o", obj->o),
+    };
+
+    /**
+     * Returns the coordinates and orientation of the [Position]
+     *
+     * @return float x
+     * @return float y
+     * @return float z
+     * @return float o
+     */
+    int Unpack(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(pos->x);
+        E->Push(pos->y);
+        E->Push(pos->z);
+        E->Push(pos->o);
+        return 4;
+    }
+
+    /**
+     * Returns the length of the [Position] as a vector from the origin, the orientation is ignored
+     *
+     * @return float length
+     */
+    int GetLength(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(pos->GetLength());
+        return 1;
+    }
+
+    /**
+     * Returns the distance between the [Position] and another [Position] in 3d space
+     *
+     * @param [Position] other
+     * @return float dist : the distance in yards
+     */
+    int GetDistance(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(pos->GetDistance(E->CHECKVAL<ElunaPosition>(2)));
+        return 1;
+    }
+
+    /**
+     * Returns the distance between the [Position] and another [Position] in 2d space, ignoring the z coordinates
+     *
+     * @param [Position] other
+     * @return float dist : the distance in yards
+     */
+    int GetDistance2d(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(pos->GetDistance2d(E->CHECKVAL<ElunaPosition>(2)));
+        return 1;
+    }
+
+    /**
+     * Returns the angle from the [Position] to another [Position] in radians, between 0 and 2 pi
+     *
+     * @param [Position] other
+     * @return float angle
+     */
+    int GetAngle(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(pos->GetAngle(E->CHECKVAL<ElunaPosition>(2)));
+        return 1;
+    }
+
+    /**
+     * Returns the [Position] of a point at a distance and angle relative to the orientation of the [Position]
+     *
+     * @param float dist : distance of the point in yards
+     * @param float angle : angle of the point relative to the orientation in radians
+     * @return [Position] point
+     */
+    int GetRelativePoint(Eluna* E, ElunaPosition* pos)
+    {
+        float dist = E->CHECKVAL<float>(2);
+        float angle = E->CHECKVAL<float>(3);
+
+        E->Push(pos->GetRelativePoint(dist, angle));
+        return 1;
+    }
+
+    /**
+     * Returns the [Position] between the [Position] and another [Position] at the given fraction of the way
+     *
+     * The orientation turns the shorter way around.
+     *
+     * @param [Position] other
+     * @param float t : 0 returns this [Position], 1 returns the other [Position]
+     * @return [Position] pos
+     */
+    int Lerp(Eluna* E, ElunaPosition* pos)
+    {
+        ElunaPosition other = E->CHECKVAL<ElunaPosition>(2);
+        float t = E->CHECKVAL<float>(3);
+
+        E->Push(pos->Lerp(other, t));
+        return 1;
+    }
+
+    int Add(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(*pos + E->CHECKVAL<ElunaPosition>(2));
+        return 1;
+    }
+
+    int Subtract(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(*pos - E->CHECKVAL<ElunaPosition>(2));
+        return 1;
+    }
+
+    // Lua passes the operands of `*` in order and the method thunk checks the first one, so only `pos * number` is supported
+    int Multiply(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(*pos * E->CHECKVAL<float>(2));
+        return 1;
+    }
+
+    int Divide(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(*pos / E->CHECKVAL<float>(2));
+        return 1;
+    }
+
+    int UnaryMinus(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(-*pos);
+        return 1;
+    }
+
+    int Equal(Eluna* E, ElunaPosition* pos)
+    {
+        E->Push(*pos == E->CHECKVAL<ElunaPosition>(2));
+        return 1;
+    }
+
+    int ToString(Eluna* E, ElunaPosition* pos)
+    {
+        std::ostringstream ss;
+        ss << "Position(" << pos->x << ", " << pos->y << ", " << pos->z << ", " << pos->o << ")";
+        E->Push(ss.str());
+        return 1;
+    }
+
+    ElunaRegister<ElunaPosition> PositionMethods[] =
+    {
+        // Getters
+        { "Unpack", &LuaPosition::Unpack },
+        { "GetLength", &LuaPosition::GetLength },
+        { "GetDistance", &LuaPosition::GetDistance },
+        { "GetDistance2d", &LuaPosition::GetDistance2d },
+        { "GetAngle", &LuaPosition::GetAngle },
+        { "GetRelativePoint", &LuaPosition::GetRelativePoint },
+
+        // Other
+        { "Lerp", &LuaPosition::Lerp },
+        { "__add", &LuaPosition::Add },
+        { "__sub", &LuaPosition::Subtract },
+        { "__mul", &LuaPosition::Multiply },
+        { "__div", &LuaPosition::Divide },
+        { "__unm", &LuaPosition::UnaryMinus },
+        { "__eq", &LuaPosition::Equal },
+        { "__tostring", &LuaPosition::ToString },
+    };
+};
+#endif
@@ -12,6 +12,9 @@
 #include "ElunaUtility.h"
 
 // Method includes
+// Template fields are used by the global template filters
+#include "ItemTemplateMethods.h"
+#include "CreatureTemplateMethods.h"
 #include "GlobalMethods.h"
 #include "ObjectMethods.h"
 #include "WorldObjectMethods.h"
@@ -35,6 +38,7 @@
 #include "VehicleMethods.h"
 #include "BattleGroundMethods.h"
 #include "BigIntMethods.h"
+#include "PositionMethods.h"
 #include "CustomMethodsInterface.h"
 
 void RegisterMethods(Eluna* E)
@@ -102,6 +106,12 @@ void RegisterMethods(Eluna* E)
     ElunaTemplate<ElunaSpellInfo>::Register(E, "ElunaSpellInfo");
     ElunaTemplate<ElunaSpellInfo>::SetMethods(E, LuaSpellInfo::SpellInfoMethods);
 
+    ElunaTemplate<ElunaItemTemplate>::Register(E, "ItemTemplate");
+    ElunaTemplate<ElunaItemTemplate>::SetFields(E, LuaItemTemplate::ItemTemplateFields);
+
+    ElunaTemplate<ElunaCreatureTemplate>::Register(E, "CreatureTemplate");
+    ElunaTemplate<ElunaCreatureTemplate>::SetFields(E, LuaCreatureTemplate::CreatureTemplateFields);
+
     ElunaTemplate<Spell>::Register(E, "Spell");
     ElunaTemplate<Spell>::SetMethods(E, LuaSpell::SpellMethods);
 
@@ -129,6 +139,10 @@ void RegisterMethods(Eluna* E)
     ElunaTemplate<ObjectGuid>::Register(E, "ObjectGuid");
     ElunaTemplate<ObjectGuid>::SetMethods(E, LuaBigInt::ObjectGuidMethods);
 
+    ElunaTemplate<ElunaPosition>::Register(E, "Position");
+    ElunaTemplate<ElunaPosition>::SetMethods(E, LuaPosition::PositionMethods);
+    ElunaTemplate<ElunaPosition>::SetFields(E, LuaPosition::PositionFields);
+
     LuaCustom::RegisterCustomMethods(E);
 
     LuaVal::Register(E->L);
@@ -284,8 +284,7 @@ namespace LuaAuraEffects
      */
     int GetSpellInfo(Eluna* E, AuraEffect* aurEff)
     {
-        ElunaSpellInfo info(aurEff->GetId());
-        E->Push(&info);
+        E->PushSpellInfo(aurEff->GetId());
         return 1;
     }
 
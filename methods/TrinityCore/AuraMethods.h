@@ -175,8 +175,7 @@ namespace LuaAura
      */
     int GetSpellInfo(Eluna* E, Aura* aura)
     {
-        ElunaSpellInfo info(aura->GetId());
-        E->Push(&info);
+        E->PushSpellInfo(aura->GetId());
         return 1;
     }
 
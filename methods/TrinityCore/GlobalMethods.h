@@ -115,6 +115,119 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
+    /**
+     * Returns the Lua time and load shedding statistics of the current state.
+     *
+     * When `Eluna.TickBudget` (in microseconds) is set, the Lua time of each tick is measured. If a tick used more than
+     * the budget, handlers registered with the `cosmetic` priority are skipped during the next tick.
+     * Only handlers of events whose return values are ignored are skipped, so a handler that can change
+     * the outcome of an event (e.g. by returning `false`) always runs. `normal` and `critical` handlers always run.
+     *
+     * The priority is passed to any Register*Event function after `shots`, for example
+     * `RegisterPlayerEvent(event, function, 0, eventPriority.cosmetic)`, and defaults to `normal`.
+     *
+     * The same budget also limits the timed events and async query callbacks run in a tick, as does `Eluna.UpdateCallLimit`
+     * (a number of calls). They stop when either limit is reached. The work left is carried over to the next tick in order of its due time.
+     *
+     * The returned table has the fields `tickTime` (Lua time of the last tick in microseconds), `budget` (in microseconds),
+     * `overrunTicks`, `shedding` (whether handlers are currently skipped) and `shed`, which maps each priority name
+     * to the amount of skipped handler calls.
+     * `carriedTimers` is the amount of objects with due timed events and `carriedCallbacks` the amount of query callbacks
+     * the last tick left over, `maxCarriedTimers` and `maxCarriedCallbacks` are the most left over by a tick and
+     * `carryOverTicks` is the amount of ticks that left work over.
+     *
+     * @return table stats
+     */
+    int GetLuaLoadStats(Eluna* E)
+    {
+        E->PushLoadStats();
+        return 1;
+    }
+
+    /**
+     * Returns the call counts and timings of the C++ methods called in the current state.
+     *
+     * Methods are only measured while method profiling is enabled, either with `Eluna.MethodProfiling` in the
+     * configuration file or with [SetMethodProfiling]. Calls that raise a Lua error are not counted.
+     *
+     * The returned array is sorted by total time, slowest first. Each entry has the fields `type` (the class name,
+     * or "Global" for global functions), `method`, `calls` and `time` (total time in nanoseconds).
+     *
+     * @return table stats
+     */
+    int GetMethodStats(Eluna* E)
+    {
+        E->PushMethodStats();
+        return 1;
+    }
+
+    /**
+     * Writes the method call counts and timings of the current state to a CSV file.
+     *
+     * The columns are `type`, `method`, `calls`, `time_ns` and `avg_ns`. An existing file is overwritten.
+     *
+     * @param string path : path of the file to write
+     * @return bool written : true if the file was written
+     */
+    int DumpMethodStats(Eluna* E)
+    {
+        std::string path = E->CHECKVAL<std::string>(1);
+
+        E->Push(E->DumpMethodStats(path));
+        return 1;
+    }
+
+    /**
+     * Enables or disables method profiling in the current state, see [GetMethodStats].
+     *
+     * The collected statistics are kept when profiling is disabled.
+     *
+     * @param bool enable = true
+     */
+    int SetMethodProfiling(Eluna* E)
+    {
+        bool enable = E->CHECKVAL<bool>(1, true);
+
+        E->SetMethodProfiling(enable);
+        return 0;
+    }
+
+    /**
+     * Clears the method call counts and timings of the current state.
+     */
+    int ResetMethodStats(Eluna* E)
+    {
+        E->ResetMethodStats();
+        return 0;
+    }
+
+    /**
+     * Returns the allocation statistics of the timed events of the current state.
+     *
+     * Timed events are allocated from chunks that are reused, these statistics show how many events are created and
+     * destroyed over time. The returned table has the fields `live` (events that exist now), `peak` (most events that existed
+     * at once), `capacity` (events that fit in the allocated chunks), `allocations` and `frees` (events created and destroyed in total).
+     *
+     * @return table stats
+     */
+    int GetTimedEventStats(Eluna* E)
+    {
+        LuaEventPool::Stats const& stats = E->eventMgr->GetEventPoolStats();
+
+        lua_createtable(E->L, 0, 5);
+        E->Push(stats.live);
+        lua_setfield(E->L, -2, "live");
+        E->Push(stats.peak);
+        lua_setfield(E->L, -2, "peak");
+        E->Push(stats.capacity);
+        lua_setfield(E->L, -2, "capacity");
+        E->Push(stats.allocations);
+        lua_setfield(E->L, -2, "allocations");
+        E->Push(stats.frees);
+        lua_setfield(E->L, -2, "frees");
+        return 1;
+    }
+
     /**
      * Returns [Quest] template
      *
@@ -560,11 +673,14 @@ namespace LuaGlobalFunctions
         uint32 ev = E->CHECKVAL<uint32>(2);
         luaL_checktype(E->L, 3, LUA_TFUNCTION);
         uint32 shots = E->CHECKVAL<uint32>(4, 0);
+        uint32 priority = E->CHECKVAL<uint32>(5, Hooks::BINDING_PRIORITY_NORMAL);
+        if (priority >= Hooks::BINDING_PRIORITY_COUNT)
+            return luaL_argerror(E->L, 5, "valid binding priority expected");
 
         lua_pushvalue(E->L, 3);
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return E->Register(regtype, id, ObjectGuid(), 0, ev, functionRef, shots);
+            return E->Register(regtype, id, ObjectGuid(), 0, ev, functionRef, shots, priority);
         else
             luaL_argerror(E->L, 3, "unable to make a ref to function");
         return 0;
@@ -575,11 +691,14 @@ namespace LuaGlobalFunctions
         uint32 ev = E->CHECKVAL<uint32>(1);
         luaL_checktype(E->L, 2, LUA_TFUNCTION);
         uint32 shots = E->CHECKVAL<uint32>(3, 0);
+        uint32 priority = E->CHECKVAL<uint32>(4, Hooks::BINDING_PRIORITY_NORMAL);
+        if (priority >= Hooks::BINDING_PRIORITY_COUNT)
+            return luaL_argerror(E->L, 4, "valid binding priority expected");
 
         lua_pushvalue(E->L, 2);
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return E->Register(regtype, 0, ObjectGuid(), 0, ev, functionRef, shots);
+            return E->Register(regtype, 0, ObjectGuid(), 0, ev, functionRef, shots, priority);
         else
             luaL_argerror(E->L, 2, "unable to make a ref to function");
         return 0;
@@ -592,11 +711,14 @@ namespace LuaGlobalFunctions
         uint32 ev = E->CHECKVAL<uint32>(3);
         luaL_checktype(E->L, 4, LUA_TFUNCTION);
         uint32 shots = E->CHECKVAL<uint32>(5, 0);
+        uint32 priority = E->CHECKVAL<uint32>(6, Hooks::BINDING_PRIORITY_NORMAL);
+        if (priority >= Hooks::BINDING_PRIORITY_COUNT)
+            return luaL_argerror(E->L, 6, "valid binding priority expected");
 
         lua_pushvalue(E->L, 4);
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef >= 0)
-            return E->Register(regtype, 0, guid, instanceId, ev, functionRef, shots);
+            return E->Register(regtype, 0, guid, instanceId, ev, functionRef, shots, priority);
         else
             luaL_argerror(E->L, 4, "unable to make a ref to function");
         return 0;
@@ -645,10 +767,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : server event ID, refer to table above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -712,14 +836,18 @@ namespace LuaGlobalFunctions
      * @values [PLAYER_EVENT_ON_UPDATE_AREA, "MAP", <event: number, player: Player, oldArea: number, newArea: number>, ""]
      * @values [PLAYER_EVENT_ON_TRADE_INIT, "MAP", <event: number, player: Player, target: Player>, "Can return false to interrupt trade"]
      * @values [PLAYER_EVENT_ON_SEND_MAIL, "MAP", <event: number, player: Player, recipientGuid: number>, "Can return false to interrupt sending"]
+     * @values [PLAYER_EVENT_ON_LEAVE_ZONE, "MAP", <event: number, player: Player, oldZone: number, newZone: number>, "Not called for the first zone seen after entering the map. newZone is 0 when the player leaves the map or logs out"]
+     * @values [PLAYER_EVENT_ON_LEAVE_AREA, "MAP", <event: number, player: Player, oldArea: number, newArea: number>, "newArea is 0 when the player leaves the map or logs out"]
      * @values [PLAYER_EVENT_ON_QUEST_STATUS_CHANGED, "MAP", <event: number, player: Player, questId: number, status: number>, ""]
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : [Player] event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -728,6 +856,43 @@ namespace LuaGlobalFunctions
         return RegisterEventHelper(E, Hooks::REGTYPE_PLAYER);
     }
 
+    /**
+     * Registers a [Player] event handler for a single item, creature, spell, quest, zone or area ID.
+     *
+     * Only handlers registered for the ID involved in the event are called, so the handler is not entered for every loot, kill, learned spell or zone change on the server.
+     * Handlers registered with [Global:RegisterPlayerEvent] for the same event are still called as well.
+     *
+     * @hook player
+     * @table
+     * @columns [Event, Entry, Parameters]
+     * @values [PLAYER_EVENT_ON_KILL_CREATURE, "creature entry", <event: number, killer: Player, killed: Creature>]
+     * @values [PLAYER_EVENT_ON_EQUIP, "item entry", <event: number, player: Player, item: Item, bag: number, slot: number>]
+     * @values [PLAYER_EVENT_ON_LOOT_ITEM, "item entry", <event: number, player: Player, item: Item, count: number>]
+     * @values [PLAYER_EVENT_ON_QUEST_ABANDON, "quest ID", <event: number, player: Player, questId: number>]
+     * @values [PLAYER_EVENT_ON_LEARN_SPELL, "spell ID", <event: number, player: Player, spellId: number>]
+     * @values [PLAYER_EVENT_ON_QUEST_STATUS_CHANGED, "quest ID", <event: number, player: Player, questId: number, status: number>]
+     * @values [PLAYER_EVENT_ON_UPDATE_ZONE, "new zone ID", <event: number, player: Player, newZone: number, newArea: number>]
+     * @values [PLAYER_EVENT_ON_UPDATE_AREA, "new area ID", <event: number, player: Player, oldArea: number, newArea: number>]
+     * @values [PLAYER_EVENT_ON_LEAVE_ZONE, "old zone ID", <event: number, player: Player, oldZone: number, newZone: number>]
+     * @values [PLAYER_EVENT_ON_LEAVE_AREA, "old area ID", <event: number, player: Player, oldArea: number, newArea: number>]
+     *
+     * @proto cancel = (entry, event, function)
+     * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
+     *
+     * @param uint32 entry : the item entry, creature entry, spell, quest, zone or area ID to bind to, refer to table above
+     * @param uint32 event : [Player] event Id, refer to table above
+     * @param function function : function to register
+     * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
+     *
+     * @return function cancel : a function that cancels the binding when called
+     */
+    int RegisterPlayerEntryEvent(Eluna* E)
+    {
+        return RegisterEntryHelper(E, Hooks::REGTYPE_PLAYER_ENTRY);
+    }
+
     /**
      * Registers a [Guild] event handler.
      *
@@ -748,10 +913,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : [Guild] event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -776,10 +943,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : [Group] event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -801,10 +970,12 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (event, function)
      * @proto cancel = (event, function, shots)
+     * @proto cancel = (event, function, shots, priority)
      *
      * @param uint32 event : [BattleGround] event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -824,11 +995,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : opcode
      * @param uint32 event : packet event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -848,11 +1021,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [Creature] entry Id
      * @param uint32 event : [Creature] gossip event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -872,11 +1047,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [GameObject] entry Id
      * @param uint32 event : [GameObject] gossip event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -885,6 +1062,64 @@ namespace LuaGlobalFunctions
         return RegisterEntryHelper(E, Hooks::REGTYPE_GAMEOBJECT_GOSSIP);
     }
 
+    /**
+     * Registers a static gossip menu for a [Creature] entry, replacing any previous one.
+     *
+     * The menu is stored on the C++ side and shown on gossip hello without calling Lua.
+     * Selecting an option opens its submenu, teleports the [Player] or closes the gossip,
+     * and only options with a `callback` enter Lua. While a static menu is registered,
+     * gossip events registered with [Global:RegisterCreatureGossipEvent] are not called for the entry.
+     *
+     * The menu maps page IDs to pages, page 1 is shown on gossip hello.
+     * A page has an npc_text ID `text` and a list of `items`.
+     * An item has a `text` and optionally an `icon`, the conditions `level` (minimum level), `class`, `money` (minimum copper)
+     * and `quest` with `questStatus` (defaults to incomplete), and one action: `callback`, `menu` (page ID) or `teleport`.
+     * The callback is called as `callback(player, object, page, option)` after the gossip is closed.
+     *
+     * <pre>
+     * RegisterCreatureGossipMenu(entry, {
+     *     [1] = { text = 1, items = {
+     *         { icon = 2, text = "Take me to Stormwind", level = 10, teleport = { map = 0, x = -8913.2, y = 554.6, z = 93.8, o = 0.6 } },
+     *         { icon = 0, text = "Tell me more", menu = 2 },
+     *     } },
+     *     [2] = { text = 2, items = {
+     *         { icon = 0, text = "Thanks", callback = function(player, creature) player:SendBroadcastMessage("Good luck!") end },
+     *     } },
+     * })
+     * </pre>
+     *
+     * @param uint32 entry : [Creature] entry Id
+     * @param table menu : the menu pages, see above
+     */
+    int RegisterCreatureGossipMenu(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        luaL_checktype(E->L, 2, LUA_TTABLE);
+
+        if (const char* error = E->RegisterGossipMenu(TYPEID_UNIT, entry, 2))
+            return luaL_argerror(E->L, 2, error);
+        return 0;
+    }
+
+    /**
+     * Registers a static gossip menu for a [GameObject] entry, replacing any previous one.
+     *
+     * The menu format is the same as for [Global:RegisterCreatureGossipMenu].
+     * While a static menu is registered, gossip events registered with [Global:RegisterGameObjectGossipEvent] are not called for the entry.
+     *
+     * @param uint32 entry : [GameObject] entry Id
+     * @param table menu : the menu pages, see [Global:RegisterCreatureGossipMenu]
+     */
+    int RegisterGameObjectGossipMenu(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        luaL_checktype(E->L, 2, LUA_TTABLE);
+
+        if (const char* error = E->RegisterGossipMenu(TYPEID_GAMEOBJECT, entry, 2))
+            return luaL_argerror(E->L, 2, error);
+        return 0;
+    }
+
     /**
      * Registers an [Item] event handler.
      *
@@ -902,11 +1137,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [Item] entry Id
      * @param uint32 event : [Item] event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -926,11 +1163,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [Item] entry Id
      * @param uint32 event : [Item] gossip event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -957,6 +1196,7 @@ namespace LuaGlobalFunctions
      * @param uint32 event : [Map] event ID, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      */
     int RegisterMapEvent(Eluna* E)
     {
@@ -981,6 +1221,7 @@ namespace LuaGlobalFunctions
      * @param uint32 event : [Map] event ID, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      */
     int RegisterInstanceEvent(Eluna* E)
     {
@@ -998,11 +1239,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (menu_id, event, function)
      * @proto cancel = (menu_id, event, function, shots)
+     * @proto cancel = (menu_id, event, function, shots, priority)
      *
      * @param uint32 menu_id : [Player] gossip menu Id
      * @param uint32 event : [Player] gossip event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1048,11 +1291,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : the ID of one or more [Creature]s
      * @param uint32 event : refer to table above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1098,12 +1343,14 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (guid, instance_id, event, function)
      * @proto cancel = (guid, instance_id, event, function, shots)
+     * @proto cancel = (guid, instance_id, event, function, shots, priority)
      *
      * @param ObjectGuid guid : the GUID of a single [Creature]
      * @param uint32 instance_id : the instance ID of a single [Creature]
      * @param uint32 event : refer to table above
      * @param function function : function that will be called when the event occurs
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1134,11 +1381,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [GameObject] entry Id
      * @param uint32 event : [GameObject] event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1179,11 +1428,13 @@ namespace LuaGlobalFunctions
      *
      * @proto cancel = (entry, event, function)
      * @proto cancel = (entry, event, function, shots)
+     * @proto cancel = (entry, event, function, shots, priority)
      *
      * @param uint32 entry : [Spell] entry Id
      * @param uint32 event : [Spell] event Id, refer to table above
      * @param function function : function to register
      * @param uint32 shots = 0 : the number of times the function will be called, 0 means "always call this function"
+     * @param uint32 priority = eventPriority.normal : the priority class of the handler, handlers of `eventPriority.cosmetic` may be skipped when Lua goes over its time budget, see [Global:GetLuaLoadStats]
      *
      * @return function cancel : a function that cancels the binding when called
      */
@@ -1316,19 +1567,8 @@ namespace LuaGlobalFunctions
         // Add an asynchronous query callback
         E->GetQueryProcessor().AddCallback(WorldDatabase.AsyncQuery(query).WithCallback([E, funcRef](QueryResult result)
         {
-            ElunaQuery* eq = result ? &result : nullptr;
-
-            // Get the Lua function from the registry
-            lua_rawgeti(E->L, LUA_REGISTRYINDEX, funcRef);
-
-            // Push the query results as a parameter
-            E->Push(eq);
-
-            // Call the Lua function
-            E->ExecuteCall(1, 0);
-
-            // Unreference the Lua function
-            luaL_unref(E->L, LUA_REGISTRYINDEX, funcRef);
+            // The callback is called from UpdateEluna, so a burst of completed queries is spread over ticks
+            E->QueueQueryCallback(funcRef, std::move(result));
         }));
         return 0;
     }
@@ -1409,19 +1649,8 @@ namespace LuaGlobalFunctions
         // Add an asynchronous query callback
         E->GetQueryProcessor().AddCallback(CharacterDatabase.AsyncQuery(query).WithCallback([E, funcRef](QueryResult result)
         {
-            ElunaQuery* eq = result ? &result : nullptr;
-
-            // Get the Lua function from the registry
-            lua_rawgeti(E->L, LUA_REGISTRYINDEX, funcRef);
-
-            // Push the query results as a parameter
-            E->Push(eq);
-
-            // Call the Lua function
-            E->ExecuteCall(1, 0);
-
-            // Unreference the Lua function
-            luaL_unref(E->L, LUA_REGISTRYINDEX, funcRef);
+            // The callback is called from UpdateEluna, so a burst of completed queries is spread over ticks
+            E->QueueQueryCallback(funcRef, std::move(result));
         }));
         return 0;
     }
@@ -1502,19 +1731,8 @@ namespace LuaGlobalFunctions
         // Add an asynchronous query callback
         E->GetQueryProcessor().AddCallback(LoginDatabase.AsyncQuery(query).WithCallback([E, funcRef](QueryResult result)
         {
-            ElunaQuery* eq = result ? &result : nullptr;
-
-            // Get the Lua function from the registry
-            lua_rawgeti(E->L, LUA_REGISTRYINDEX, funcRef);
-
-            // Push the query results as a parameter
-            E->Push(eq);
-
-            // Call the Lua function
-            E->ExecuteCall(1, 0);
-
-            // Unreference the Lua function
-            luaL_unref(E->L, LUA_REGISTRYINDEX, funcRef);
+            // The callback is called from UpdateEluna, so a burst of completed queries is spread over ticks
+            E->QueueQueryCallback(funcRef, std::move(result));
         }));
         return 0;
     }
@@ -1526,15 +1744,21 @@ namespace LuaGlobalFunctions
      *
      * Repeats will decrease on each call if the event does not repeat indefinitely
      *
+     * When `Eluna.SpreadRepeatingEvents` is enabled, repeating events with a fixed delay and no jitter have their first call
+     * delayed so that the events of the same delay are spread evenly over it, instead of all being called on the same tick.
+     *
      * @proto eventId = (function, delay)
      * @proto eventId = (function, delaytable)
      * @proto eventId = (function, delay, repeats)
      * @proto eventId = (function, delaytable, repeats)
+     * @proto eventId = (function, delay, repeats, jitter)
+     * @proto eventId = (function, delaytable, repeats, jitter)
      *
      * @param function function : function to trigger when the time has passed
      * @param uint32 delay : set time in milliseconds for the event to trigger
      * @param table delaytable : a table `{min, max}` containing the minimum and maximum delay time
      * @param uint32 repeats = 1 : how many times for the event to repeat, 0 is infinite
+     * @param uint32 jitter = 0 : the first call is delayed by a random time up to this many milliseconds, which spreads events that are registered together
      * @return int eventId : unique ID for the timed event used to cancel it or nil
      */
     int CreateLuaEvent(Eluna* E)
@@ -1554,6 +1778,7 @@ namespace LuaGlobalFunctions
         else
             min = max = E->CHECKVAL<uint32>(2);
         uint32 repeats = E->CHECKVAL<uint32>(3, 1);
+        uint32 jitter = E->CHECKVAL<uint32>(4, 0);
 
         if (min > max)
             return luaL_argerror(E->L, 2, "min is bigger than max delay");
@@ -1562,12 +1787,42 @@ namespace LuaGlobalFunctions
         int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
         if (functionRef != LUA_REFNIL && functionRef != LUA_NOREF)
         {
-            E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS)->AddEvent(functionRef, min, max, repeats);
+            E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS)->AddEvent(functionRef, min, max, repeats, jitter);
             E->Push(functionRef);
         }
         return 1;
     }
 
+    /**
+     * Starts a coroutine that can wait with `Sleep` and `WaitUntil` instead of nesting timed events.
+     *
+     * The function is called with the extra arguments right away and runs until it waits or ends.
+     * `Sleep(ms)` suspends it for `ms` milliseconds. `WaitUntil(predicate, timeout, interval)` suspends it until `predicate` returns true,
+     * which is checked every `interval` milliseconds (every update by default) without resuming the coroutine.
+     * WaitUntil returns false if `timeout` milliseconds (0 for none) pass first or the predicate raises an error.
+     * A plain `coroutine.yield(...)` waits for the next update, whatever values it yields.
+     *
+     * The coroutine waits like a global timed event and can be removed with [Global:RemoveEventById] using the returned ID.
+     * Coroutines of a [WorldObject] are started with [WorldObject:StartCoroutine].
+     *
+     *     StartCoroutine(function(text)
+     *         print(text)
+     *         Sleep(1000)
+     *         local ok = WaitUntil(function() return GetPlayerCount() > 0 end, 60000, 500)
+     *         print(ok and "a player logged in" or "nobody logged in")
+     *     end, "started")
+     *
+     * @param function function : function to run as a coroutine
+     * @param ... : the arguments passed to the function
+     * @return int eventId : unique ID of the coroutine, or nil if it ended without waiting
+     */
+    int StartCoroutine(Eluna* E)
+    {
+        luaL_checktype(E->L, 1, LUA_TFUNCTION);
+        E->StartCoroutine(E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS), 1);
+        return 1;
+    }
+
     /**
      * Removes a global timed event specified by ID.
      *
@@ -2528,6 +2783,26 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
+    /**
+     * Returns a new [Position] with the given coordinates and orientation.
+     *
+     * @param float x = 0
+     * @param float y = 0
+     * @param float z = 0
+     * @param float o = 0 : orientation
+     * @return [Position] pos
+     */
+    int CreatePosition(Eluna* E)
+    {
+        float x = E->CHECKVAL<float>(1, 0.0f);
+        float y = E->CHECKVAL<float>(2, 0.0f);
+        float z = E->CHECKVAL<float>(3, 0.0f);
+        float o = E->CHECKVAL<float>(4, 0.0f);
+
+        E->Push(ElunaPosition(x, y, z, o));
+        return 1;
+    }
+
     /**
      * Unbinds event handlers for either all [BattleGround] events, or one type of event.
      *
@@ -2739,6 +3014,32 @@ namespace LuaGlobalFunctions
         return 0;
     }
 
+    /**
+     * Removes the static gossip menu of a [Creature] entry, see [Global:RegisterCreatureGossipMenu].
+     *
+     * @param uint32 entry : [Creature] entry Id
+     */
+    int ClearCreatureGossipMenu(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+
+        E->ClearGossipMenu(TYPEID_UNIT, entry);
+        return 0;
+    }
+
+    /**
+     * Removes the static gossip menu of a [GameObject] entry, see [Global:RegisterGameObjectGossipMenu].
+     *
+     * @param uint32 entry : [GameObject] entry Id
+     */
+    int ClearGameObjectGossipMenu(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+
+        E->ClearGossipMenu(TYPEID_GAMEOBJECT, entry);
+        return 0;
+    }
+
     /**
      * Unbinds event handlers for either all [Group] events, or one type of [Group] event.
      *
@@ -2928,6 +3229,39 @@ namespace LuaGlobalFunctions
         return 0;
     }
 
+    /**
+     * Unbinds event handlers for either all [Player] events bound to an entry, or one type of event.
+     *
+     * If `event_type` is `nil`, all [Player] event handlers bound to `entry` are cleared.
+     *
+     * Otherwise, only event handlers for `event_type` are cleared.
+     *
+     * @proto (entry)
+     * @proto (entry, event_type)
+     * @param uint32 entry : the item entry, creature entry, spell, quest, zone or area ID whose handlers will be cleared
+     * @param uint32 event_type : the event whose handlers will be cleared, see [Global:RegisterPlayerEntryEvent]
+     */
+    int ClearPlayerEntryEvents(Eluna* E)
+    {
+        typedef EntryKey<Hooks::PlayerEvents> Key;
+        auto binding = E->GetBinding<Key>(Hooks::REGTYPE_PLAYER_ENTRY);
+
+        if (lua_isnoneornil(E->L, 2))
+        {
+            uint32 entry = E->CHECKVAL<uint32>(1);
+
+            for (uint32 i = 1; i < Hooks::PLAYER_EVENT_COUNT; ++i)
+                binding->Clear(Key((Hooks::PlayerEvents)i, entry));
+        }
+        else
+        {
+            uint32 entry = E->CHECKVAL<uint32>(1);
+            uint32 event_type = E->CHECKVAL<uint32>(2);
+            binding->Clear(Key((Hooks::PlayerEvents)event_type, entry));
+        }
+        return 0;
+    }
+
     /**
      * Unbinds event handlers for either all of a [Player]'s gossip events, or one type of event.
      *
@@ -3068,8 +3402,253 @@ namespace LuaGlobalFunctions
         uint32 spellId = E->CHECKVAL<uint32>(1);
         if (!sSpellMgr->GetSpellInfo(spellId))
             return luaL_argerror(E->L, 1, "invalid spell id");
-        ElunaSpellInfo info(spellId);
-        E->Push(&info);
+        E->PushSpellInfo(spellId);
+        return 1;
+    }
+
+    enum SpellColumns
+    {
+        SPELL_COLUMN_ID,
+        SPELL_COLUMN_SCHOOLMASK,
+        SPELL_COLUMN_DMGCLASS,
+        SPELL_COLUMN_MECHANIC,
+        SPELL_COLUMN_FAMILYNAME,
+        SPELL_COLUMN_ATTRIBUTES,
+        SPELL_COLUMN_SPELLLEVEL,
+        SPELL_COLUMN_BASELEVEL,
+        SPELL_COLUMN_MAXLEVEL,
+        SPELL_COLUMN_POWERTYPE,
+        SPELL_COLUMN_MANACOST,
+        SPELL_COLUMN_CATEGORY,
+        SPELL_COLUMN_RECOVERYTIME,
+        SPELL_COLUMN_CATEGORYRECOVERYTIME,
+        SPELL_COLUMN_DURATION,
+        SPELL_COLUMN_MAXRANGE,
+        SPELL_COLUMN_SPEED,
+        SPELL_COLUMN_PROCCHANCE,
+        SPELL_COLUMN_PASSIVE,
+        SPELL_COLUMN_COUNT
+    };
+
+    const char* const SpellColumnNames[SPELL_COLUMN_COUNT] =
+    {
+        "id", "schoolMask", "dmgClass", "mechanic", "familyName", "attributes", "spellLevel", "baseLevel", "maxLevel",
+        "powerType", "manaCost", "category", "recoveryTime", "categoryRecoveryTime", "duration", "maxRange", "speed",
+        "procChance", "passive"
+    };
+
+    void PushSpellColumn(Eluna* E, SpellInfo const* spellInfo, uint32 column)
+    {
+        switch (column)
+        {
+            case SPELL_COLUMN_ID: E->Push(spellInfo->Id); break;
+            case SPELL_COLUMN_SCHOOLMASK: E->Push(spellInfo->SchoolMask); break;
+            case SPELL_COLUMN_DMGCLASS: E->Push(spellInfo->DmgClass); break;
+            case SPELL_COLUMN_MECHANIC: E->Push(spellInfo->Mechanic); break;
+            case SPELL_COLUMN_FAMILYNAME: E->Push(spellInfo->SpellFamilyName); break;
+            case SPELL_COLUMN_ATTRIBUTES: E->Push(spellInfo->Attributes); break;
+            case SPELL_COLUMN_SPELLLEVEL: E->Push(spellInfo->SpellLevel); break;
+            case SPELL_COLUMN_BASELEVEL: E->Push(spellInfo->BaseLevel); break;
+            case SPELL_COLUMN_MAXLEVEL: E->Push(spellInfo->MaxLevel); break;
+            case SPELL_COLUMN_POWERTYPE: E->Push(spellInfo->PowerType); break;
+            case SPELL_COLUMN_MANACOST: E->Push(spellInfo->ManaCost); break;
+            case SPELL_COLUMN_CATEGORY: E->Push(spellInfo->GetCategory()); break;
+            case SPELL_COLUMN_RECOVERYTIME: E->Push(spellInfo->RecoveryTime); break;
+            case SPELL_COLUMN_CATEGORYRECOVERYTIME: E->Push(spellInfo->CategoryRecoveryTime); break;
+            case SPELL_COLUMN_DURATION: E->Push(spellInfo->GetDuration()); break;
+            case SPELL_COLUMN_MAXRANGE: E->Push(spellInfo->GetMaxRange()); break;
+            case SPELL_COLUMN_SPEED: E->Push(spellInfo->Speed); break;
+            case SPELL_COLUMN_PROCCHANCE: E->Push(spellInfo->ProcChance); break;
+            case SPELL_COLUMN_PASSIVE: E->Push(spellInfo->IsPassive()); break;
+            default: E->Push(); break;
+        }
+    }
+
+    /**
+     * Returns the selected fields of several spells in a single call, as one array per field.
+     *
+     * Every array is aligned with `spellIds`, so `columns.manaCost[i]` belongs to `spellIds[i]`.
+     * Spells that do not exist leave nil at their index, so iterate the arrays up to `#spellIds`.
+     * The values are the same as returned by the matching [SpellInfo] getters.
+     *
+     * @table
+     * @columns [Field, Getter]
+     * @values [id, "[SpellInfo:GetId]"]
+     * @values [schoolMask, "[SpellInfo:GetSchoolMask]"]
+     * @values [dmgClass, "[SpellInfo:GetDmgClass]"]
+     * @values [mechanic, "[SpellInfo:GetMechanic]"]
+     * @values [familyName, "[SpellInfo:GetSpellFamilyName]"]
+     * @values [attributes, "[SpellInfo:GetAttributes]"]
+     * @values [spellLevel, "[SpellInfo:GetSpellLevel]"]
+     * @values [baseLevel, "[SpellInfo:GetBaseLevel]"]
+     * @values [maxLevel, "[SpellInfo:GetMaxLevel]"]
+     * @values [powerType, "[SpellInfo:GetPowerType]"]
+     * @values [manaCost, "[SpellInfo:GetManaCost]"]
+     * @values [category, "[SpellInfo:GetCategory]"]
+     * @values [recoveryTime, "[SpellInfo:GetRecoveryTime]"]
+     * @values [categoryRecoveryTime, "[SpellInfo:GetCategoryRecoveryTime]"]
+     * @values [duration, "[SpellInfo:GetDuration]"]
+     * @values [maxRange, "[SpellInfo:GetMaxRange]"]
+     * @values [speed, "[SpellInfo:GetSpeed]"]
+     * @values [procChance, "[SpellInfo:GetProcChance]"]
+     * @values [passive, "[SpellInfo:IsPassive]"]
+     *
+     * @param table spellIds : the spell IDs to read, for example `{ 133, 116, 1459 }`
+     * @param table fields : field names, for example `{ "manaCost", "duration" }`
+     * @return table columns : field names mapped to arrays of values
+     */
+    int GetSpellInfoColumns(Eluna* E)
+    {
+        luaL_checktype(E->L, 1, LUA_TTABLE);
+        luaL_checktype(E->L, 2, LUA_TTABLE);
+        lua_settop(E->L, 2);
+
+        std::vector<uint32> columns;
+        for (int i = 1; ; ++i)
+        {
+            lua_rawgeti(E->L, 2, i);
+            if (lua_isnil(E->L, -1))
+            {
+                lua_pop(E->L, 1);
+                break;
+            }
+
+            if (lua_type(E->L, -1) != LUA_TSTRING)
+                return luaL_argerror(E->L, 2, "field names expected");
+
+            const char* name = lua_tostring(E->L, -1);
+            uint32 column = 0;
+            while (column < SPELL_COLUMN_COUNT && strcmp(name, SpellColumnNames[column]) != 0)
+                ++column;
+
+            if (column == SPELL_COLUMN_COUNT)
+                return luaL_argerror(E->L, 2, lua_pushfstring(E->L, "unknown field '%s'", name));
+
+            columns.push_back(column);
+            lua_pop(E->L, 1);
+        }
+
+        int count = static_cast<int>(lua_rawlen(E->L, 1));
+        std::vector<SpellInfo const*> spells(count);
+        for (int i = 1; i <= count; ++i)
+        {
+            // Each ID is checked at index 3, the first free slot of the stack
+            lua_rawgeti(E->L, 1, i);
+            spells[i - 1] = sSpellMgr->GetSpellInfo(E->CHECKVAL<uint32>(3));
+            lua_pop(E->L, 1);
+        }
+
+        lua_createtable(E->L, 0, static_cast<int>(columns.size()));
+        int tbl = lua_gettop(E->L);
+
+        for (uint32 column : columns)
+        {
+            lua_createtable(E->L, count, 0);
+            for (int i = 0; i < count; ++i)
+            {
+                if (!spells[i])
+                    continue;
+
+                PushSpellColumn(E, spells[i], column);
+                lua_rawseti(E->L, -2, i + 1);
+            }
+            lua_setfield(E->L, tbl, SpellColumnNames[column]);
+        }
+
+        return 1;
+    }
+
+    /**
+     * Returns the read-only [ItemTemplate] of the item entry, or nil if the entry does not exist.
+     *
+     * The same userdata is returned for every call with the same entry.
+     *
+     * @param uint32 entry : the item entry
+     * @return [ItemTemplate] itemTemplate
+     */
+    int GetItemTemplateView(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        E->PushTemplateView(eObjectMgr->GetItemTemplate(entry));
+        return 1;
+    }
+
+    /**
+     * Returns a table with the read-only [ItemTemplate]s whose fields match the filter, in no particular order.
+     *
+     * Each filter field maps to a value or to an inclusive `{ min, max }` range, and a template
+     *   matches when all of the fields match. The name can't be filtered by.
+     * The templates are matched without entering Lua, so only the matching templates are pushed.
+     *
+     * @param table filter = nil : field names mapped to values or ranges, for example `{ class = 2, quality = 4, itemLevel = { 60, 70 } }`
+     * @return table itemTemplates
+     */
+    int GetItemTemplates(Eluna* E)
+    {
+        ElunaFieldFilter<ElunaItemTemplate> filter;
+        if (const char* error = filter.Load(E->L, 1, ElunaTemplate<ElunaItemTemplate>::GetFieldTable(LuaItemTemplate::ItemTemplateFields)))
+            return luaL_argerror(E->L, 1, error);
+
+        std::vector<ItemTemplate const*> matches;
+        for (auto const& itr : sObjectMgr->GetItemTemplateStore())
+        {
+            ElunaItemTemplate view(&itr.second);
+            if (filter.Matches(&view))
+                matches.push_back(&itr.second);
+        }
+
+        lua_createtable(E->L, static_cast<int>(matches.size()), 0);
+        for (size_t i = 0; i < matches.size(); ++i)
+        {
+            E->PushTemplateView(matches[i]);
+            lua_rawseti(E->L, -2, static_cast<int>(i + 1));
+        }
+        return 1;
+    }
+
+    /**
+     * Returns the read-only [CreatureTemplate] of the creature entry, or nil if the entry does not exist.
+     *
+     * The same userdata is returned for every call with the same entry.
+     *
+     * @param uint32 entry : the creature entry
+     * @return [CreatureTemplate] creatureTemplate
+     */
+    int GetCreatureTemplateView(Eluna* E)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        E->PushTemplateView(eObjectMgr->GetCreatureTemplate(entry));
+        return 1;
+    }
+
+    /**
+     * Returns a table with the read-only [CreatureTemplate]s whose fields match the filter, in no particular order.
+     *
+     * The filter works like the filter of [GetItemTemplates].
+     *
+     * @param table filter = nil : field names mapped to values or ranges, for example `{ type = 1, rank = { 1, 3 } }`
+     * @return table creatureTemplates
+     */
+    int GetCreatureTemplates(Eluna* E)
+    {
+        ElunaFieldFilter<ElunaCreatureTemplate> filter;
+        if (const char* error = filter.Load(E->L, 1, ElunaTemplate<ElunaCreatureTemplate>::GetFieldTable(LuaCreatureTemplate::CreatureTemplateFields)))
+            return luaL_argerror(E->L, 1, error);
+
+        std::vector<CreatureTemplate const*> matches;
+        for (auto const& itr : sObjectMgr->GetCreatureTemplates())
+        {
+            ElunaCreatureTemplate view(&itr.second);
+            if (filter.Matches(&view))
+                matches.push_back(&itr.second);
+        }
+
+        lua_createtable(E->L, static_cast<int>(matches.size()), 0);
+        for (size_t i = 0; i < matches.size(); ++i)
+        {
+            E->PushTemplateView(matches[i]);
+            lua_rawseti(E->L, -2, static_cast<int>(i + 1));
+        }
         return 1;
     }
 
@@ -3079,6 +3658,7 @@ namespace LuaGlobalFunctions
         { "RegisterPacketEvent", &LuaGlobalFunctions::RegisterPacketEvent },
         { "RegisterServerEvent", &LuaGlobalFunctions::RegisterServerEvent },
         { "RegisterPlayerEvent", &LuaGlobalFunctions::RegisterPlayerEvent },
+        { "RegisterPlayerEntryEvent", &LuaGlobalFunctions::RegisterPlayerEntryEvent },
         { "RegisterGuildEvent", &LuaGlobalFunctions::RegisterGuildEvent },
         { "RegisterGroupEvent", &LuaGlobalFunctions::RegisterGroupEvent },
         { "RegisterCreatureEvent", &LuaGlobalFunctions::RegisterCreatureEvent },
@@ -3086,6 +3666,8 @@ namespace LuaGlobalFunctions
         { "RegisterCreatureGossipEvent", &LuaGlobalFunctions::RegisterCreatureGossipEvent },
         { "RegisterGameObjectEvent", &LuaGlobalFunctions::RegisterGameObjectEvent },
         { "RegisterGameObjectGossipEvent", &LuaGlobalFunctions::RegisterGameObjectGossipEvent },
+        { "RegisterCreatureGossipMenu", &LuaGlobalFunctions::RegisterCreatureGossipMenu },
+        { "RegisterGameObjectGossipMenu", &LuaGlobalFunctions::RegisterGameObjectGossipMenu },
         { "RegisterSpellEvent", &LuaGlobalFunctions::RegisterSpellEvent },
         { "RegisterItemEvent", &LuaGlobalFunctions::RegisterItemEvent },
         { "RegisterItemGossipEvent", &LuaGlobalFunctions::RegisterItemGossipEvent },
@@ -3100,12 +3682,15 @@ namespace LuaGlobalFunctions
         { "ClearCreatureGossipEvents", &LuaGlobalFunctions::ClearCreatureGossipEvents },
         { "ClearGameObjectEvents", &LuaGlobalFunctions::ClearGameObjectEvents },
         { "ClearGameObjectGossipEvents", &LuaGlobalFunctions::ClearGameObjectGossipEvents },
+        { "ClearCreatureGossipMenu", &LuaGlobalFunctions::ClearCreatureGossipMenu },
+        { "ClearGameObjectGossipMenu", &LuaGlobalFunctions::ClearGameObjectGossipMenu },
         { "ClearGroupEvents", &LuaGlobalFunctions::ClearGroupEvents },
         { "ClearGuildEvents", &LuaGlobalFunctions::ClearGuildEvents },
         { "ClearItemEvents", &LuaGlobalFunctions::ClearItemEvents },
         { "ClearItemGossipEvents", &LuaGlobalFunctions::ClearItemGossipEvents },
         { "ClearPacketEvents", &LuaGlobalFunctions::ClearPacketEvents },
         { "ClearPlayerEvents", &LuaGlobalFunctions::ClearPlayerEvents },
+        { "ClearPlayerEntryEvents", &LuaGlobalFunctions::ClearPlayerEntryEvents },
         { "ClearPlayerGossipEvents", &LuaGlobalFunctions::ClearPlayerGossipEvents },
         { "ClearServerEvents", &LuaGlobalFunctions::ClearServerEvents },
         { "ClearMapEvents", &LuaGlobalFunctions::ClearMapEvents },
@@ -3120,6 +3705,12 @@ namespace LuaGlobalFunctions
         { "GetStateMap", &LuaGlobalFunctions::GetStateMap, METHOD_REG_MAP }, // Map state method only in multistate
         { "GetStateMapId", &LuaGlobalFunctions::GetStateMapId },
         { "GetStateInstanceId", &LuaGlobalFunctions::GetStateInstanceId },
+        { "GetLuaLoadStats", &LuaGlobalFunctions::GetLuaLoadStats },
+        { "GetMethodStats", &LuaGlobalFunctions::GetMethodStats },
+        { "DumpMethodStats", &LuaGlobalFunctions::DumpMethodStats },
+        { "SetMethodProfiling", &LuaGlobalFunctions::SetMethodProfiling },
+        { "ResetMethodStats", &LuaGlobalFunctions::ResetMethodStats },
+        { "GetTimedEventStats", &LuaGlobalFunctions::GetTimedEventStats },
         { "GetQuest", &LuaGlobalFunctions::GetQuest },
         { "GetPlayerByGUID", &LuaGlobalFunctions::GetPlayerByGUID, METHOD_REG_WORLD }, // World state method only in multistate
         { "GetPlayerByName", &LuaGlobalFunctions::GetPlayerByName, METHOD_REG_WORLD }, // World state method only in multistate
@@ -3152,6 +3743,11 @@ namespace LuaGlobalFunctions
         { "PrintDebug", &LuaGlobalFunctions::PrintDebug },
         { "GetActiveGameEvents", &LuaGlobalFunctions::GetActiveGameEvents },
         { "GetSpellInfo", &LuaGlobalFunctions::GetSpellInfo },
+        { "GetSpellInfoColumns", &LuaGlobalFunctions::GetSpellInfoColumns },
+        { "GetItemTemplateView", &LuaGlobalFunctions::GetItemTemplateView },
+        { "GetItemTemplates", &LuaGlobalFunctions::GetItemTemplates },
+        { "GetCreatureTemplateView", &LuaGlobalFunctions::GetCreatureTemplateView },
+        { "GetCreatureTemplates", &LuaGlobalFunctions::GetCreatureTemplates },
 
         // Boolean
         { "IsCompatibilityMode", &LuaGlobalFunctions::IsCompatibilityMode },
@@ -3175,6 +3771,7 @@ namespace LuaGlobalFunctions
         { "AuthDBExecute", &LuaGlobalFunctions::AuthDBExecute },
         { "AuthDBQueryAsync", &LuaGlobalFunctions::AuthDBQueryAsync },
         { "CreateLuaEvent", &LuaGlobalFunctions::CreateLuaEvent },
+        { "StartCoroutine", &LuaGlobalFunctions::StartCoroutine },
         { "RemoveEventById", &LuaGlobalFunctions::RemoveEventById },
         { "RemoveEvents", &LuaGlobalFunctions::RemoveEvents },
         { "PerformIngameSpawn", &LuaGlobalFunctions::PerformIngameSpawn },
@@ -3189,6 +3786,7 @@ namespace LuaGlobalFunctions
         { "AddTaxiPath", &LuaGlobalFunctions::AddTaxiPath },
         { "CreateInt64", &LuaGlobalFunctions::CreateLongLong },
         { "CreateUint64", &LuaGlobalFunctions::CreateULongLong },
+        { "CreatePosition", &LuaGlobalFunctions::CreatePosition },
         { "StartGameEvent", &LuaGlobalFunctions::StartGameEvent },
         { "StopGameEvent", &LuaGlobalFunctions::StopGameEvent }
     };
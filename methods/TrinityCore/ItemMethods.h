@@ -451,7 +451,7 @@ namespace LuaItem
      */
     int GetName(Eluna* E, Item* item)
     {
-        E->Push(item->GetTemplate()->Name1);
+        E->PushCachedString(item->GetTemplate()->Name1);
         return 1;
     }
 
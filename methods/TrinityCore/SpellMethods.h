@@ -177,8 +177,7 @@ namespace LuaSpell
      */
     int GetSpellInfo(Eluna* E, Spell* spell)
     {
-        ElunaSpellInfo info(spell->GetSpellInfo()->Id);
-        E->Push(&info);
+        E->PushSpellInfo(spell->GetSpellInfo()->Id);
         return 1;
     }
 
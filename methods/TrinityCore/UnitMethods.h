@@ -2003,19 +2003,25 @@ namespace LuaUnit
     /**
      * The [Unit] will move to the coordinates
      *
+     * @proto (id, x, y, z, genPath)
+     * @proto (id, pos, genPath)
+     *
      * @param uint32 id : unique waypoint Id
      * @param float x
      * @param float y
      * @param float z
+     * @param [Position] pos
      * @param bool genPath = true : if true, generates path
      */
     int MoveTo(Eluna* E, Unit* unit)
     {
         uint32 id = E->CHECKVAL<uint32>(2);
-        float x = E->CHECKVAL<float>(3);
-        float y = E->CHECKVAL<float>(4);
-        float z = E->CHECKVAL<float>(5);
-        bool genPath = E->CHECKVAL<bool>(6, true);
+        ElunaPosition pos;
+        int narg = E->CHECKPOS(3, pos);
+        float x = pos.x;
+        float y = pos.y;
+        float z = pos.z;
+        bool genPath = E->CHECKVAL<bool>(narg, true);
 
         unit->GetMotionMaster()->MovePoint(id, x, y, z, genPath);
         return 0;
@@ -2357,19 +2363,21 @@ namespace LuaUnit
     /**
      * Makes the [Unit] teleport to given coordinates within same map.
      *
+     * @proto (x, y, z, o)
+     * @proto (pos)
+     *
      * @param float x
      * @param float y
      * @param float z
      * @param float o : orientation
+     * @param [Position] pos
      */
     int NearTeleport(Eluna* E, Unit* unit)
     {
-        float x = E->CHECKVAL<float>(2);
-        float y = E->CHECKVAL<float>(3);
-        float z = E->CHECKVAL<float>(4);
-        float o = E->CHECKVAL<float>(5);
+        ElunaPosition pos;
+        E->CHECKPOS(2, pos, true);
 
-        unit->NearTeleportTo(x, y, z, o);
+        unit->NearTeleportTo(pos.x, pos.y, pos.z, pos.o);
         return 0;
     }
 
@@ -2600,6 +2608,265 @@ namespace LuaUnit
         return 0;
     }
 
+    enum SnapshotFields
+    {
+        SNAPSHOT_X,
+        SNAPSHOT_Y,
+        SNAPSHOT_Z,
+        SNAPSHOT_O,
+        SNAPSHOT_MAP,
+        SNAPSHOT_ENTRY,
+        SNAPSHOT_GUIDLOW,
+        SNAPSHOT_LEVEL,
+        SNAPSHOT_HEALTH,
+        SNAPSHOT_MAXHEALTH,
+        SNAPSHOT_POWERTYPE,
+        SNAPSHOT_POWER,
+        SNAPSHOT_MAXPOWER,
+        SNAPSHOT_FACTION,
+        SNAPSHOT_DISPLAYID,
+        SNAPSHOT_ALIVE,
+        SNAPSHOT_INCOMBAT,
+        SNAPSHOT_FIELD_COUNT
+    };
+
+    // Field names in SnapshotFields order
+    const char* const SnapshotFieldNames[SNAPSHOT_FIELD_COUNT] =
+    {
+        "x", "y", "z", "o", "map", "entry", "guidLow", "level", "health", "maxHealth",
+        "powerType", "power", "maxPower", "faction", "displayId", "alive", "inCombat"
+    };
+
+    // Fields of the predefined field sets, indexed by set ID
+    const uint32 SnapshotFieldSets[] =
+    {
+        0,
+        // 1: position
+        (1 << SNAPSHOT_X) | (1 << SNAPSHOT_Y) | (1 << SNAPSHOT_Z) | (1 << SNAPSHOT_O) | (1 << SNAPSHOT_MAP),
+        // 2: vitals
+        (1 << SNAPSHOT_LEVEL) | (1 << SNAPSHOT_HEALTH) | (1 << SNAPSHOT_MAXHEALTH) | (1 << SNAPSHOT_POWERTYPE) |
+        (1 << SNAPSHOT_POWER) | (1 << SNAPSHOT_MAXPOWER) | (1 << SNAPSHOT_ALIVE) | (1 << SNAPSHOT_INCOMBAT),
+        // 3: all
+        (1 << SNAPSHOT_FIELD_COUNT) - 1
+    };
+
+    void PushSnapshotField(Eluna* E, Unit* unit, uint32 field)
+    {
+        switch (field)
+        {
+            case SNAPSHOT_X: E->Push(unit->GetPositionX()); break;
+            case SNAPSHOT_Y: E->Push(unit->GetPositionY()); break;
+            case SNAPSHOT_Z: E->Push(unit->GetPositionZ()); break;
+            case SNAPSHOT_O: E->Push(unit->GetOrientation()); break;
+            case SNAPSHOT_MAP: E->Push(unit->GetMapId()); break;
+            case SNAPSHOT_ENTRY: E->Push(unit->GetEntry()); break;
+            case SNAPSHOT_GUIDLOW: E->Push(unit->GetGUID().GetCounter()); break;
+            case SNAPSHOT_LEVEL: E->Push(unit->GetLevel()); break;
+            case SNAPSHOT_HEALTH: E->Push(unit->GetHealth()); break;
+            case SNAPSHOT_MAXHEALTH: E->Push(unit->GetMaxHealth()); break;
+            case SNAPSHOT_POWERTYPE: E->Push(unit->GetPowerType()); break;
+            case SNAPSHOT_POWER: E->Push(unit->GetPower(unit->GetPowerType())); break;
+            case SNAPSHOT_MAXPOWER: E->Push(unit->GetMaxPower(unit->GetPowerType())); break;
+            case SNAPSHOT_FACTION: E->Push(unit->GetFaction()); break;
+            case SNAPSHOT_DISPLAYID: E->Push(unit->GetDisplayId()); break;
+            case SNAPSHOT_ALIVE: E->Push(unit->IsAlive()); break;
+            case SNAPSHOT_INCOMBAT: E->Push(unit->IsInCombat()); break;
+            default: E->Push(); break;
+        }
+    }
+
+    /**
+     * Returns a table with several properties of the [Unit], read in a single call.
+     *
+     * The fields are given either as a table of field names or as the ID of a predefined field set.
+     * Power fields refer to the [Unit]'s current power type.
+     * If `target` is given the fields are written to it and it is returned, so the same table can be reused.
+     *
+     * @table
+     * @columns [Field, Sets]
+     * @values [x, "1, 3"]
+     * @values [y, "1, 3"]
+     * @values [z, "1, 3"]
+     * @values [o, "1, 3"]
+     * @values [map, "1, 3"]
+     * @values [entry, "3"]
+     * @values [guidLow, "3"]
+     * @values [level, "2, 3"]
+     * @values [health, "2, 3"]
+     * @values [maxHealth, "2, 3"]
+     * @values [powerType, "2, 3"]
+     * @values [power, "2, 3"]
+     * @values [maxPower, "2, 3"]
+     * @values [faction, "3"]
+     * @values [displayId, "3"]
+     * @values [alive, "2, 3"]
+     * @values [inCombat, "2, 3"]
+     *
+     * @proto snapshot = (fields[, target])
+     * @proto snapshot = (fieldSet[, target])
+     * @param table fields : field names, for example `{ "x", "y", "health" }`
+     * @param uint32 fieldSet : 1 position, 2 vitals, 3 all
+     * @param table target : table to write the fields to
+     * @return table snapshot : field names mapped to their values
+     */
+    int Snapshot(Eluna* E, Unit* unit)
+    {
+        uint32 fields = 0;
+        if (lua_istable(E->L, 2))
+        {
+            for (int i = 1; ; ++i)
+            {
+                lua_rawgeti(E->L, 2, i);
+                if (lua_isnil(E->L, -1))
+                {
+                    lua_pop(E->L, 1);
+                    break;
+                }
+
+                const char* name = lua_tostring(E->L, -1);
+                uint32 field = 0;
+                while (name && field < SNAPSHOT_FIELD_COUNT && strcmp(name, SnapshotFieldNames[field]) != 0)
+                    ++field;
+
+                if (field == SNAPSHOT_FIELD_COUNT || !name)
+                    return luaL_argerror(E->L, 2, "valid field names expected");
+
+                fields |= 1 << field;
+                lua_pop(E->L, 1);
+            }
+        }
+        else
+        {
+            uint32 fieldSet = E->CHECKVAL<uint32>(2);
+            if (!fieldSet || fieldSet >= std::size(SnapshotFieldSets))
+                return luaL_argerror(E->L, 2, "valid field set expected");
+
+            fields = SnapshotFieldSets[fieldSet];
+        }
+
+        if (lua_istable(E->L, 3))
+            lua_pushvalue(E->L, 3);
+        else
+            lua_createtable(E->L, 0, SNAPSHOT_FIELD_COUNT);
+        int tbl = lua_gettop(E->L);
+
+        for (uint32 field = 0; field < SNAPSHOT_FIELD_COUNT; ++field)
+        {
+            if (!(fields & (1 << field)))
+                continue;
+
+            PushSnapshotField(E, unit, field);
+            lua_setfield(E->L, tbl, SnapshotFieldNames[field]);
+        }
+
+        return 1;
+    }
+
+    /**
+     * Sets several properties of the [Unit] from a table in a single call.
+     *
+     * Fields that are missing from the table are not changed. The fields are applied in the order
+     *   level, maxHealth, health, maxPower, power, faction, displayId, so a new maximum applies before the current value.
+     * Power fields refer to the [Unit]'s current power type. Setting the level of a [Player] works like [Unit:SetLevel].
+     * All fields are checked before any is set, an unknown field name or an invalid value raises an error and changes nothing.
+     * The other fields of a [Unit:Snapshot] table, like `x` or `alive`, are ignored.
+     *
+     * @param table fields : field names mapped to new values, see [Unit:Snapshot] for the names
+     */
+    int Apply(Eluna* E, Unit* unit)
+    {
+        luaL_checktype(E->L, 2, LUA_TTABLE);
+
+        static const uint32 applyOrder[] =
+        {
+            SNAPSHOT_LEVEL, SNAPSHOT_MAXHEALTH, SNAPSHOT_HEALTH, SNAPSHOT_MAXPOWER, SNAPSHOT_POWER, SNAPSHOT_FACTION, SNAPSHOT_DISPLAYID
+        };
+
+        // A misspelled field would otherwise be ignored silently
+        lua_pushnil(E->L);
+        while (lua_next(E->L, 2) != 0)
+        {
+            lua_pop(E->L, 1);
+            const char* name = lua_type(E->L, -1) == LUA_TSTRING ? lua_tostring(E->L, -1) : nullptr;
+
+            uint32 field = 0;
+            while (name && field < SNAPSHOT_FIELD_COUNT && strcmp(name, SnapshotFieldNames[field]) != 0)
+                ++field;
+
+            if (!name)
+                return luaL_argerror(E->L, 2, lua_pushfstring(E->L, "field names expected, got %s", luaL_typename(E->L, -1)));
+            if (field == SNAPSHOT_FIELD_COUNT)
+                return luaL_argerror(E->L, 2, lua_pushfstring(E->L, "unknown field '%s'", name));
+        }
+
+        // Every field is read and checked before any is applied, so an invalid table changes nothing
+        uint32 values[SNAPSHOT_FIELD_COUNT];
+        bool present[SNAPSHOT_FIELD_COUNT] = {};
+        for (uint32 field : applyOrder)
+        {
+            const char* name = SnapshotFieldNames[field];
+            lua_getfield(E->L, 2, name);
+            if (lua_isnil(E->L, -1))
+            {
+                lua_pop(E->L, 1);
+                continue;
+            }
+
+            lua_Number number = lua_tonumber(E->L, -1);
+            if (!lua_isnumber(E->L, -1) || number != std::floor(number) || number < 0 || number > UINT32_MAX)
+                return luaL_argerror(E->L, 2, lua_pushfstring(E->L, "field '%s' must be an unsigned 32-bit integer", name));
+
+            uint32 value = static_cast<uint32>(number);
+            if (field == SNAPSHOT_LEVEL && (value < 1 || value > UINT8_MAX))
+                return luaL_argerror(E->L, 2, lua_pushfstring(E->L, "field '%s' must be between 1 and 255", name));
+
+            values[field] = value;
+            present[field] = true;
+            lua_pop(E->L, 1);
+        }
+
+        for (uint32 field : applyOrder)
+        {
+            if (!present[field])
+                continue;
+
+            uint32 value = values[field];
+            switch (field)
+            {
+                case SNAPSHOT_LEVEL:
+                    if (Player* player = unit->ToPlayer())
+                    {
+                        player->GiveLevel(value);
+                        player->InitTalentForLevel();
+                        player->SetUInt32Value(PLAYER_XP, 0);
+                    }
+                    else
+                        unit->SetLevel(value);
+                    break;
+                case SNAPSHOT_MAXHEALTH:
+                    unit->SetMaxHealth(value);
+                    break;
+                case SNAPSHOT_HEALTH:
+                    unit->SetHealth(value);
+                    break;
+                case SNAPSHOT_MAXPOWER:
+                    unit->SetMaxPower(unit->GetPowerType(), value);
+                    break;
+                case SNAPSHOT_POWER:
+                    unit->SetPower(unit->GetPowerType(), value);
+                    break;
+                case SNAPSHOT_FACTION:
+                    unit->SetFaction(value);
+                    break;
+                case SNAPSHOT_DISPLAYID:
+                    unit->SetDisplayId(value);
+                    break;
+            }
+        }
+
+        return 0;
+    }
+
     ElunaRegister<Unit> UnitMethods[] =
     {
         // Getters
@@ -2728,6 +2995,8 @@ namespace LuaUnit
         { "CanModifyStats", &LuaUnit::CanModifyStats },
 
         // Other
+        { "Snapshot", &LuaUnit::Snapshot },
+        { "Apply", &LuaUnit::Apply },
         { "AddAura", &LuaUnit::AddAura },
         { "RemoveAura", &LuaUnit::RemoveAura },
         { "RemoveAllAuras", &LuaUnit::RemoveAllAuras },
@@ -0,0 +1,39 @@
+/*
+* Copyright (C) 2010 - 2024 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef CREATURETEMPLATEMETHODS_H
+#define CREATURETEMPLATEMETHODS_H
+
+/***
+ * Read-only view of a creature template, shared by all scripts of the state.
+ *
+ * The template's fields are read directly, for example `template.rank`, and the same
+ *   userdata is returned for every lookup of the same template.
+ * Use [GetCreatureTemplateView] to get the template of an entry and [GetCreatureTemplates] to find templates by their fields.
+ *
+ * Fields: `entry`, `name`, `subName`, `minLevel`, `maxLevel`, `faction`, `npcFlags`, `rank`, `type`, `family`, `unitClass`, `extraFlags`.
+ *
+ * Inherits all methods from: none
+ */
+namespace LuaCreatureTemplate
+{
+    ElunaField<ElunaCreatureTemplate> const CreatureTemplateFields[] =
+    {
+        ELUNA_FIELD(ElunaCreatureTemplate, "entry", obj->Get()->entry),
+        ELUNA_STRING_FIELD(ElunaCreatureTemplate, "name", obj->Get()->name),
+        ELUNA_STRING_FIELD(ElunaCreatureTemplate, "subName", obj->Get()->subname),
+        ELUNA_FIELD(ElunaCreatureTemplate, "minLevel", obj->Get()->level_min),
+        ELUNA_FIELD(ElunaCreatureTemplate, "maxLevel", obj->Get()->level_max),
+        ELUNA_FIELD(ElunaCreatureTemplate, "faction", obj->Get()->faction),
+        ELUNA_FIELD(ElunaCreatureTemplate, "npcFlags", obj->Get()->npc_flags),
+        ELUNA_FIELD(ElunaCreatureTemplate, "rank", uint32(obj->Get()->rank)),
+        ELUNA_FIELD(ElunaCreatureTemplate, "type", uint32(obj->Get()->type)),
+        ELUNA_FIELD(ElunaCreatureTemplate, "family", uint32(obj->Get()->pet_family)),
+        ELUNA_FIELD(ElunaCreatureTemplate, "unitClass", obj->Get()->unit_class),
+        ELUNA_FIELD(ElunaCreatureTemplate, "extraFlags", obj->Get()->flags_extra),
+    };
+};
+#endif